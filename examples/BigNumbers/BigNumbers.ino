@@ -0,0 +1,54 @@
+/*
+  LiquidCrystal Library - BigNumbers
+
+ Demonstrates the use of a 20x4 LCD display with digits four rows tall,
+ readable from across the room.
+
+ The digits are made from two custom characters (a top bar and a bottom
+ bar) plus the full block built into the display, so six of the eight
+ custom character locations are still free for the sketch. Only the cells
+ of digits that changed are rewritten.
+
+ The circuit:
+ * LCD RS pin to digital pin 12
+ * LCD Enable pin to digital pin 11
+ * LCD D4 pin to digital pin 5
+ * LCD D5 pin to digital pin 4
+ * LCD D6 pin to digital pin 3
+ * LCD D7 pin to digital pin 2
+ * LCD R/W pin to ground
+ * 10K or 100K potentiometer:
+   * ends to +5V and ground
+   * wiper to LCD VO pin (pin 3)
+
+ This example code is in the public domain.
+*/
+
+// include the library code:
+#include <LiquidCrystal.h>
+#include <LiquidCrystal_BigNumbers.h>
+
+// initialize the library by associating any needed LCD interface pin
+// with the Arduino pin number it is connected to
+const int rs = 12, en = 11, d4 = 5, d5 = 4, d6 = 3, d7 = 2;
+LiquidCrystal lcd(rs, en, d4, d5, d6, d7);
+LiquidCrystal_BigNumbers big(lcd, 20, 4);
+
+void setup() {
+  // set up the LCD's number of columns and rows:
+  lcd.begin(20, 4);
+  // define the segment glyphs:
+  big.begin();
+}
+
+void loop() {
+  // count the seconds since reset, right aligned in five digits:
+  unsigned long seconds = millis() / 1000;
+  big.setCursor(0);
+  for (unsigned long limit = 10000; limit > 1 && seconds < limit;
+       limit /= 10) {
+    big.print(' ');
+  }
+  big.print(seconds);
+  delay(100);
+}
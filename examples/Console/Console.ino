@@ -0,0 +1,59 @@
+/*
+  LiquidCrystal Library - Console
+
+ Demonstrates the use of a 20x4 LCD display as a scrolling event log.
+
+ Every line printed to the console goes below the previous one, and once
+ the bottom row is reached the rows scroll up. Scrolling rewrites only the
+ cells that change, so log lines that start alike cost little.
+
+ The circuit:
+ * LCD RS pin to digital pin 12
+ * LCD Enable pin to digital pin 11
+ * LCD D4 pin to digital pin 5
+ * LCD D5 pin to digital pin 4
+ * LCD D6 pin to digital pin 3
+ * LCD D7 pin to digital pin 2
+ * LCD R/W pin to ground
+ * 10K or 100K potentiometer:
+   * ends to +5V and ground
+   * wiper to LCD VO pin (pin 3)
+
+ This example code is in the public domain.
+*/
+
+// include the library code:
+#include <LiquidCrystal.h>
+#include <LiquidCrystal_Console.h>
+
+// initialize the library by associating any needed LCD interface pin
+// with the Arduino pin number it is connected to
+const int rs = 12, en = 11, d4 = 5, d5 = 4, d6 = 3, d7 = 2;
+LiquidCrystal lcd(rs, en, d4, d5, d6, d7);
+
+// what the display shows, and what the console shows
+uint8_t shadow[20 * 4];
+uint8_t logBuffer[20 * 4];
+LiquidCrystal_Console console(lcd, logBuffer, 20, 4);
+
+int lastReading = -1;
+
+void setup() {
+  // set up the LCD's number of columns and rows:
+  lcd.begin(20, 4);
+  lcd.attachShadow(shadow);
+  console.clear();
+  console.println("Log started");
+}
+
+void loop() {
+  // log the reading on A0 whenever it moves by more than a little:
+  int reading = analogRead(A0);
+  if (abs(reading - lastReading) > 50) {
+    lastReading = reading;
+    console.print(millis() / 1000);
+    console.print("s A0=");
+    console.println(reading);
+  }
+  delay(100);
+}
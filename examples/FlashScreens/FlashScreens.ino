@@ -0,0 +1,62 @@
+/*
+  LiquidCrystal Library - FlashScreens
+
+ Demonstrates the use of a 16x2 LCD display with screen templates kept in
+ flash memory.
+
+ drawScreen() sends a whole template straight from flash, one run per row,
+ padding every row to the width of the display so the old screen is
+ replaced without a clear(). The fields say where the live values go.
+
+ The circuit:
+ * LCD RS pin to digital pin 12
+ * LCD Enable pin to digital pin 11
+ * LCD D4 pin to digital pin 5
+ * LCD D5 pin to digital pin 4
+ * LCD D6 pin to digital pin 3
+ * LCD D7 pin to digital pin 2
+ * LCD R/W pin to ground
+ * 10K or 100K potentiometer:
+   * ends to +5V and ground
+   * wiper to LCD VO pin (pin 3)
+
+ This example code is in the public domain.
+*/
+
+// include the library code:
+#include <LiquidCrystal.h>
+
+// initialize the library by associating any needed LCD interface pin
+// with the Arduino pin number it is connected to
+const int rs = 12, en = 11, d4 = 5, d5 = 4, d6 = 3, d7 = 2;
+LiquidCrystal lcd(rs, en, d4, d5, d6, d7);
+
+// the screens, one line of text per row
+const char sensorScreen[] PROGMEM = "Sensor A0:\n"
+                                    "Uptime:       s";
+const char aboutScreen[] PROGMEM = "Jellyfish ECM\n"
+                                   "LCD demo";
+
+// where the values go on the sensor screen: column, row and width
+const LiquidCrystal_Field readingField PROGMEM = {11, 0, 4};
+const LiquidCrystal_Field uptimeField PROGMEM = {8, 1, 6};
+
+void setup() {
+  // set up the LCD's number of columns and rows:
+  lcd.begin(16, 2);
+}
+
+void loop() {
+  lcd.drawScreen((const __FlashStringHelper *)aboutScreen);
+  delay(2000);
+
+  lcd.drawScreen((const __FlashStringHelper *)sensorScreen);
+  for (int i = 0; i < 20; i++) {
+    lcd.setCursor(&readingField);
+    lcd.print(analogRead(A0));
+    lcd.print(F("   "));
+    lcd.setCursor(&uptimeField);
+    lcd.print(millis() / 1000);
+    delay(200);
+  }
+}
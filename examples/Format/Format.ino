@@ -0,0 +1,59 @@
+/*
+  LiquidCrystal Library - Format
+
+ Demonstrates the use of a 16x2 LCD display with values printed into
+ fixed-width fields by LCD_PRINTF().
+
+ The format is checked and taken apart when the sketch compiles, so a
+ mistake in it is a build error, and printing a value is only turning it
+ into digits. The field is always as wide as the format says: a short
+ reading clears what a longer one left, and one that doesn't fit shows as
+ #s. With a shadow attached, the characters that already show are not
+ sent again.
+
+ The circuit:
+ * LCD RS pin to digital pin 12
+ * LCD Enable pin to digital pin 11
+ * LCD D4 pin to digital pin 5
+ * LCD D5 pin to digital pin 4
+ * LCD D6 pin to digital pin 3
+ * LCD D7 pin to digital pin 2
+ * LCD R/W pin to ground
+ * 10K or 100K potentiometer:
+   * ends to +5V and ground
+   * wiper to LCD VO pin (pin 3)
+
+ This example code is in the public domain.
+*/
+
+// include the library code:
+#include <LiquidCrystal.h>
+#include <LiquidCrystal_Format.h>
+
+// initialize the library by associating any needed LCD interface pin
+// with the Arduino pin number it is connected to
+const int rs = 12, en = 11, d4 = 5, d5 = 4, d6 = 3, d7 = 2;
+LiquidCrystal lcd(rs, en, d4, d5, d6, d7);
+
+// what the display shows, so unchanged characters can be skipped
+uint8_t shadow[16 * 2];
+
+void setup() {
+  // set up the LCD's number of columns and rows:
+  lcd.begin(16, 2);
+  lcd.attachShadow(shadow);
+}
+
+void loop() {
+  // A0 as a voltage, and the raw reading in hex
+  int reading = analogRead(A0);
+  lcd.setCursor(0, 0);
+  LCD_PRINTF(lcd, "A0 %4.2f V", reading * 5.0 / 1023);
+  lcd.setCursor(12, 0);
+  LCD_PRINTF(lcd, "%03X", reading);
+
+  // the seconds since reset
+  lcd.setCursor(0, 1);
+  LCD_PRINTF(lcd, "Up %8lu s", millis() / 1000);
+  delay(200);
+}
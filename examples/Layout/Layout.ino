@@ -0,0 +1,61 @@
+/*
+  LiquidCrystal Library - Layout
+
+ Demonstrates the use of a 16x2 LCD display with a screen layout that the
+ compiler checks and turns into a table in flash.
+
+ The labels and the fields the values go in are described once. The build
+ fails if one of them runs off the display or overlaps another, and
+ drawing the screen is a walk over precomputed display addresses.
+
+ The circuit:
+ * LCD RS pin to digital pin 12
+ * LCD Enable pin to digital pin 11
+ * LCD D4 pin to digital pin 5
+ * LCD D5 pin to digital pin 4
+ * LCD D6 pin to digital pin 3
+ * LCD D7 pin to digital pin 2
+ * LCD R/W pin to ground
+ * 10K or 100K potentiometer:
+   * ends to +5V and ground
+   * wiper to LCD VO pin (pin 3)
+
+ This example code is in the public domain.
+*/
+
+// include the library code:
+#include <LiquidCrystal.h>
+
+// initialize the library by associating any needed LCD interface pin
+// with the Arduino pin number it is connected to
+const int rs = 12, en = 11, d4 = 5, d5 = 4, d6 = 3, d7 = 2;
+LiquidCrystal lcd(rs, en, d4, d5, d6, d7);
+
+// the labels, in flash
+constexpr LiquidCrystal_Geometry panel = {16, 2};
+constexpr char sensorLabel[] PROGMEM = "A0:";
+constexpr char uptimeLabel[] PROGMEM = "Up:";
+constexpr char secondsLabel[] PROGMEM = "s";
+
+// the screen: labels, and fields of a given width for the values
+LCD_LAYOUT(screen, panel,
+           lcdText(panel, 0, 0, sensorLabel),
+           lcdField(panel, 4, 0, 4),
+           lcdText(panel, 0, 1, uptimeLabel),
+           lcdField(panel, 4, 1, 6),
+           lcdText(panel, 10, 1, secondsLabel));
+
+void setup() {
+  // set up the LCD's number of columns and rows:
+  lcd.begin(16, 2);
+  lcd.drawLayout(screen);
+}
+
+void loop() {
+  lcd.setCursor(&screen[1]);
+  lcd.print(analogRead(A0));
+  lcd.print(F("   "));
+  lcd.setCursor(&screen[3]);
+  lcd.print(millis() / 1000);
+  delay(200);
+}
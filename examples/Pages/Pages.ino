@@ -0,0 +1,66 @@
+/*
+  LiquidCrystal Library - Pages
+
+ Demonstrates the use of a 16x2 LCD display with several off-screen
+ pages, flipping between them without clearing the display.
+
+ Each page is a buffer with its own cursor and cursor/blink settings.
+ Printing to a page doesn't touch the display; show() sends only the
+ cells that differ from what the display already shows.
+
+ The circuit:
+ * LCD RS pin to digital pin 12
+ * LCD Enable pin to digital pin 11
+ * LCD D4 pin to digital pin 5
+ * LCD D5 pin to digital pin 4
+ * LCD D6 pin to digital pin 3
+ * LCD D7 pin to digital pin 2
+ * LCD R/W pin to ground
+ * 10K or 100K potentiometer:
+   * ends to +5V and ground
+   * wiper to LCD VO pin (pin 3)
+
+ This example code is in the public domain.
+*/
+
+// include the library code:
+#include <LiquidCrystal.h>
+#include <LiquidCrystal_Page.h>
+
+// initialize the library by associating any needed LCD interface pin
+// with the Arduino pin number it is connected to
+const int rs = 12, en = 11, d4 = 5, d5 = 4, d6 = 3, d7 = 2;
+LiquidCrystal lcd(rs, en, d4, d5, d6, d7);
+
+// what the display shows, and one buffer per page
+uint8_t shadow[16 * 2];
+uint8_t readingBuffer[16 * 2];
+uint8_t menuBuffer[16 * 2];
+LiquidCrystal_Page readingPage(lcd, readingBuffer, 16, 2);
+LiquidCrystal_Page menuPage(lcd, menuBuffer, 16, 2);
+
+void setup() {
+  // set up the LCD's number of columns and rows:
+  lcd.begin(16, 2);
+  lcd.attachShadow(shadow);
+
+  readingPage.print("Sensor A0:");
+  menuPage.print("> Calibrate");
+  menuPage.setCursor(0, 1);
+  menuPage.print("  Back");
+  menuPage.setCursor(0, 0);
+  menuPage.blink();
+}
+
+void loop() {
+  // update the reading page, then show it for a second:
+  readingPage.setCursor(11, 0);
+  readingPage.print(analogRead(A0));
+  readingPage.print("   ");
+  readingPage.show();
+  delay(1000);
+
+  // flip to the menu; only the differing cells are sent:
+  menuPage.show();
+  delay(1000);
+}
@@ -0,0 +1,63 @@
+/*
+  LiquidCrystal Library - Readings
+
+ Demonstrates the use of a 16x2 LCD display to show a sensor that is only
+ redrawn when its value really changes.
+
+ A0 is read every time through loop(), but the field only changes when the
+ reading moves by more than a few counts, at most four times a second, so
+ noise doesn't make the last digit flicker and a steady sensor sends
+ nothing to the display. The reading also switches a fan on above 800 and
+ off again below 780.
+
+ The circuit:
+ * LCD RS pin to digital pin 12
+ * LCD Enable pin to digital pin 11
+ * LCD D4 pin to digital pin 5
+ * LCD D5 pin to digital pin 4
+ * LCD D6 pin to digital pin 3
+ * LCD D7 pin to digital pin 2
+ * LCD R/W pin to ground
+ * 10K or 100K potentiometer:
+   * ends to +5V and ground
+   * wiper to LCD VO pin (pin 3)
+ * sensor output to analog pin A0
+ * fan relay to digital pin 13
+
+ This example code is in the public domain.
+*/
+
+// include the library code:
+#include <LiquidCrystal.h>
+#include <LiquidCrystal_Reading.h>
+
+// initialize the library by associating any needed LCD interface pin
+// with the Arduino pin number it is connected to
+const int rs = 12, en = 11, d4 = 5, d5 = 4, d6 = 3, d7 = 2;
+LiquidCrystal lcd(rs, en, d4, d5, d6, d7);
+
+// columns 4 to 7 of the first row
+LiquidCrystal_Reading sensor(lcd, 4, 0, 4);
+
+const int fan = 13;
+
+void setup() {
+  pinMode(fan, OUTPUT);
+  // set up the LCD's number of columns and rows:
+  lcd.begin(16, 2);
+  lcd.print("A0:");
+
+  sensor.setDeadband(3);
+  sensor.setInterval(250, 5000);
+  sensor.setThreshold(800, 20);
+}
+
+void loop() {
+  uint8_t events = sensor.update(analogRead(A0));
+  if (events & LCD_READING_ABOVE) {
+    digitalWrite(fan, HIGH);
+  }
+  if (events & LCD_READING_BELOW) {
+    digitalWrite(fan, LOW);
+  }
+}
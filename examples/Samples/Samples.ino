@@ -0,0 +1,81 @@
+/*
+  LiquidCrystal Library - Samples
+
+ Demonstrates the use of a 16x2 LCD display to show a sensor that is read
+ a thousand times a second, while the display updates four times a second.
+
+ Every reading goes into a LiquidCrystal_Samples channel, which keeps the
+ lowest, highest and mean reading since the display last looked. The
+ display only ever gets the summary, and it draws it through a back buffer
+ with a time budget, so no pass of loop() spends long on it and no reading
+ is missed. In a real sketch the readings would come from a timer or ADC
+ interrupt; see LiquidCrystal_Samples.h.
+
+ The circuit:
+ * LCD RS pin to digital pin 12
+ * LCD Enable pin to digital pin 11
+ * LCD D4 pin to digital pin 5
+ * LCD D5 pin to digital pin 4
+ * LCD D6 pin to digital pin 3
+ * LCD D7 pin to digital pin 2
+ * LCD R/W pin to ground
+ * 10K or 100K potentiometer:
+   * ends to +5V and ground
+   * wiper to LCD VO pin (pin 3)
+ * sensor output to analog pin A0
+
+ This example code is in the public domain.
+*/
+
+// include the library code:
+#include <LiquidCrystal.h>
+#include <LiquidCrystal_Samples.h>
+
+// initialize the library by associating any needed LCD interface pin
+// with the Arduino pin number it is connected to
+const int rs = 12, en = 11, d4 = 5, d5 = 4, d6 = 3, d7 = 2;
+LiquidCrystal lcd(rs, en, d4, d5, d6, d7);
+
+// what the display shows, and what it is being brought to
+uint8_t shadow[16 * 2];
+uint8_t back[16 * 2];
+
+LiquidCrystal_Samples sensor;
+unsigned long lastSample = 0;
+unsigned long lastShown = 0;
+
+void setup() {
+  // set up the LCD's number of columns and rows:
+  lcd.begin(16, 2);
+  lcd.attachShadow(shadow);
+  lcd.attachBackBuffer(back);
+  // four frames a second, at most half a millisecond of each pass of loop()
+  lcd.setFrameRate(4, 500);
+}
+
+void loop() {
+  // a reading every millisecond
+  unsigned long now = micros();
+  if (now - lastSample >= 1000) {
+    lastSample = now;
+    sensor.add(analogRead(A0), now);
+  }
+
+  // the summary, four times a second
+  LiquidCrystal_Window window;
+  if (millis() - lastShown >= 250 && sensor.window(window)) {
+    lastShown = millis();
+    lcd.clear();
+    lcd.print("mean ");
+    lcd.print(window.mean());
+    lcd.print(" n=");
+    lcd.print(window.count);
+    lcd.setCursor(0, 1);
+    lcd.print(window.min);
+    lcd.print("..");
+    lcd.print(window.max);
+  }
+
+  // send a little of the frame
+  lcd.refresh();
+}
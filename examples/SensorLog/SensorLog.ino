@@ -0,0 +1,72 @@
+/*
+  LiquidCrystal Library - SensorLog
+
+ Demonstrates logging a sensor in the compact binary form of SensorLog
+ while a 16x2 LCD display shows the latest reading.
+
+ A0 is read every millisecond and logged to the serial port in 64-byte
+ blocks, about four bytes a reading. Capture the port to a file and turn
+ it into CSV on the computer:
+
+   stty -F /dev/ttyUSB0 115200 raw
+   cat /dev/ttyUSB0 > log.bin
+   scripts/sensor_log.py log.bin > log.csv
+
+ To log to an SD card instead, pass the open File and a 512-byte block, so
+ that every write is one whole sector.
+
+ The circuit:
+ * LCD RS pin to digital pin 12
+ * LCD Enable pin to digital pin 11
+ * LCD D4 pin to digital pin 5
+ * LCD D5 pin to digital pin 4
+ * LCD D6 pin to digital pin 3
+ * LCD D7 pin to digital pin 2
+ * LCD R/W pin to ground
+ * 10K or 100K potentiometer:
+   * ends to +5V and ground
+   * wiper to LCD VO pin (pin 3)
+ * sensor output to analog pin A0
+
+ This example code is in the public domain.
+*/
+
+// include the library code:
+#include <LiquidCrystal.h>
+#include <SensorLog.h>
+
+// initialize the library by associating any needed LCD interface pin
+// with the Arduino pin number it is connected to
+const int rs = 12, en = 11, d4 = 5, d5 = 4, d6 = 3, d7 = 2;
+LiquidCrystal lcd(rs, en, d4, d5, d6, d7);
+
+uint8_t block[64];
+SensorLog sensorLog(Serial, block, sizeof(block));
+
+unsigned long lastSample = 0;
+unsigned long lastShown = 0;
+
+void setup() {
+  Serial.begin(115200);
+  // set up the LCD's number of columns and rows:
+  lcd.begin(16, 2);
+  lcd.print("Logging A0");
+}
+
+void loop() {
+  // a reading every millisecond, logged as channel 0
+  unsigned long now = micros();
+  if (now - lastSample >= 1000) {
+    lastSample = now;
+    int reading = analogRead(A0);
+    sensorLog.add(0, reading, now);
+
+    // and shown twice a second
+    if (millis() - lastShown >= 500) {
+      lastShown = millis();
+      lcd.setCursor(0, 1);
+      lcd.print(reading);
+      lcd.print("    ");
+    }
+  }
+}
@@ -0,0 +1,55 @@
+/*
+  LiquidCrystal Library - Serial Mirror
+
+ Demonstrates the use of a 16x2 LCD display whose contents are also sent
+ over the serial port, so that someone can see what it shows without
+ standing in front of it. On the computer, run
+
+   scripts/lcd_mirror.py /dev/ttyUSB0
+
+ from the library folder (after setting the port to 115200 baud, raw).
+ Only the cells that change are sent, at most five times a second.
+
+ The circuit:
+ * LCD RS pin to digital pin 12
+ * LCD Enable pin to digital pin 11
+ * LCD D4 pin to digital pin 5
+ * LCD D5 pin to digital pin 4
+ * LCD D6 pin to digital pin 3
+ * LCD D7 pin to digital pin 2
+ * LCD R/W pin to ground
+ * 10K or 100K potentiometer:
+   * ends to +5V and ground
+   * wiper to LCD VO pin (pin 3)
+
+ This example code is in the public domain.
+*/
+
+// include the library code:
+#include <LiquidCrystal.h>
+#include <LiquidCrystal_Mirror.h>
+
+// initialize the library by associating any needed LCD interface pin
+// with the Arduino pin number it is connected to
+const int rs = 12, en = 11, d4 = 5, d5 = 4, d6 = 3, d7 = 2;
+LiquidCrystal lcd(rs, en, d4, d5, d6, d7);
+
+// what the display shows, which the mirror sends from
+uint8_t shadow[16 * 2];
+LiquidCrystal_Mirror mirror(lcd, Serial);
+
+void setup() {
+  Serial.begin(115200);
+  // set up the LCD's number of columns and rows:
+  lcd.begin(16, 2);
+  lcd.attachShadow(shadow);
+  mirror.begin();
+  lcd.print("Uptime:");
+}
+
+void loop() {
+  lcd.setCursor(0, 1);
+  lcd.print(millis() / 1000);
+  // send whatever changed, if it is time to
+  mirror.update();
+}
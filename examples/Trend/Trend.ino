@@ -0,0 +1,56 @@
+/*
+  LiquidCrystal Library - Trend
+
+ Demonstrates the use of a 16x2 LCD display with a scrolling graph of the
+ last 30 seconds of readings, drawn with custom characters.
+
+ The graph takes 6 custom characters, 30x8 pixels. Each new reading only
+ changes its own pixel column, so only the glyph rows it touches are sent
+ to the display.
+
+ The circuit:
+ * LCD RS pin to digital pin 12
+ * LCD Enable pin to digital pin 11
+ * LCD D4 pin to digital pin 5
+ * LCD D5 pin to digital pin 4
+ * LCD D6 pin to digital pin 3
+ * LCD D7 pin to digital pin 2
+ * LCD R/W pin to ground
+ * 10K or 100K potentiometer:
+   * ends to +5V and ground
+   * wiper to LCD VO pin (pin 3)
+ * pressure sensor (or a potentiometer) on analog pin A0
+
+ This example code is in the public domain.
+*/
+
+// include the library code:
+#include <LiquidCrystal.h>
+#include <LiquidCrystal_Canvas.h>
+#include <LiquidCrystal_Trend.h>
+
+// initialize the library by associating any needed LCD interface pin
+// with the Arduino pin number it is connected to
+const int rs = 12, en = 11, d4 = 5, d5 = 4, d6 = 3, d7 = 2;
+LiquidCrystal lcd(rs, en, d4, d5, d6, d7);
+
+// a 6x1 cell canvas, with readings from 0 to 1023 spanning its height
+LiquidCrystal_Canvas canvas(lcd, 6, 1);
+LiquidCrystal_Trend trend(canvas, 0, 1023);
+
+void setup() {
+  // set up the LCD's number of columns and rows:
+  lcd.begin(16, 2);
+  lcd.print("Pressure, 30 s");
+  canvas.begin();
+  trend.show(10, 1);
+}
+
+void loop() {
+  int reading = analogRead(A0);
+  lcd.setCursor(0, 1);
+  lcd.print(reading);
+  lcd.print("    ");
+  trend.add(reading);
+  delay(1000);
+}
@@ -0,0 +1,144 @@
+#include "Controller.h"
+
+#include <string.h>
+
+#include "Arduino.h"
+#include "HostHal.h"
+
+Controller::Controller(uint8_t rs, uint8_t rw, uint8_t enable, uint8_t d4,
+                       uint8_t d5, uint8_t d6, uint8_t d7) {
+  _rs = rs;
+  _rw = rw;
+  _enable = enable;
+  _data[0] = d4;
+  _data[1] = d5;
+  _data[2] = d6;
+  _data[3] = d7;
+  _haveHigh = _haveReadHigh = false;
+  _high = _read = 0;
+  memset(ddram, ' ', sizeof(ddram));
+  memset(cgram, 0, sizeof(cgram));
+  ac = 0;
+  cgramMode = false;
+  eightBit = true; // the controller powers up in 8-bit mode
+  twoLine = false;
+  increment = true;
+  displayControl = 0;
+  resetCounts();
+  hal::setPinHook(onPin, this);
+}
+
+Controller::~Controller() { hal::setPinHook(0, 0); }
+
+const char *Controller::text(uint8_t address, uint8_t count) {
+  for (uint8_t i = 0; i < count && i < 128; i++) {
+    _text[i] = ddram[(address + i) & 0x7F];
+  }
+  _text[count < 128 ? count : 128] = '\0';
+  return _text;
+}
+
+void Controller::onPin(uint8_t pin, uint8_t value, void *context) {
+  Controller *controller = static_cast<Controller *>(context);
+  if (pin == controller->_enable && value == HIGH) {
+    controller->pulse();
+  }
+}
+
+void Controller::pulse() {
+  if (_rw != 255 && hal::pins[_rw]) {
+    read();
+    return;
+  }
+  uint8_t value = 0;
+  for (int i = 0; i < 4; i++) {
+    if (hal::pins[_data[i]]) {
+      value |= 0x10 << i;
+    }
+  }
+  if (eightBit) {
+    apply(hal::pins[_rs], value); // d0-d3 aren't wired, so they read 0
+  } else if (!_haveHigh) {
+    _high = value;
+    _haveHigh = true;
+  } else {
+    _haveHigh = false;
+    apply(hal::pins[_rs], _high | (value >> 4));
+  }
+}
+
+void Controller::read() {
+  if (_haveReadHigh) {
+    _haveReadHigh = false;
+    drive(_read);
+    return;
+  }
+  if (hal::pins[_rs]) {
+    _read = cgramMode ? cgram[ac & 0x3F] : ddram[ac & 0x7F];
+    step(increment);
+  } else {
+    _read = ac; // never busy: the driver's delays are long enough
+  }
+  reads++;
+  _haveReadHigh = true;
+  drive(_read >> 4);
+}
+
+void Controller::drive(uint8_t nibble) {
+  for (int i = 0; i < 4; i++) {
+    hal::pins[_data[i]] = (nibble >> i) & 1;
+  }
+}
+
+void Controller::step(bool forward) {
+  if (cgramMode) {
+    ac = (ac + (forward ? 1 : -1)) & 0x3F;
+  } else if (!twoLine) {
+    ac = forward ? (ac >= 0x4F ? 0x00 : ac + 1) : (ac ? ac - 1 : 0x4F);
+  } else if (forward) {
+    ac = (ac == 0x27) ? 0x40 : (ac >= 0x67 ? 0x00 : ac + 1);
+  } else {
+    ac = (ac == 0x40) ? 0x27 : (ac ? ac - 1 : 0x67);
+  }
+}
+
+void Controller::apply(bool rsHigh, uint8_t value) {
+  if (rsHigh) {
+    writes++;
+    if (cgramMode) {
+      cgram[ac & 0x3F] = value;
+    } else {
+      ddram[ac & 0x7F] = value;
+    }
+    step(increment);
+    return;
+  }
+
+  commands++;
+  if (value & 0x80) {
+    cgramMode = false;
+    ac = value & 0x7F;
+  } else if (value & 0x40) {
+    cgramMode = true;
+    ac = value & 0x3F;
+  } else if (value & 0x20) {
+    eightBit = value & 0x10;
+    twoLine = value & 0x08;
+  } else if (value & 0x10) {
+    if (!(value & 0x08)) { // cursor move
+      step(value & 0x04);
+    }
+  } else if (value & 0x08) {
+    displayControl = value & 0x07;
+  } else if (value & 0x04) {
+    increment = value & 0x02;
+  } else if (value & 0x02) {
+    ac = 0;
+    cgramMode = false;
+  } else if (value & 0x01) {
+    memset(ddram, ' ', sizeof(ddram));
+    ac = 0;
+    cgramMode = false;
+    increment = true;
+  }
+}
@@ -0,0 +1,49 @@
+#ifndef Controller_h
+#define Controller_h
+
+#include <stdint.h>
+
+// A model of an HD44780 on the fake HAL's pins, for the host test and
+// benchmark. It decodes every byte the driver sends into its own DDRAM,
+// CGRAM and address counter, answers reads, and counts what it saw.
+class Controller {
+public:
+  // 4-bit wiring; rw may be 255 when the driver doesn't use it
+  Controller(uint8_t rs, uint8_t rw, uint8_t enable, uint8_t d4, uint8_t d5,
+             uint8_t d6, uint8_t d7);
+  ~Controller();
+
+  void resetCounts() { commands = writes = reads = 0; }
+  // the `count` DDRAM bytes from `address` as a string, for comparisons
+  const char *text(uint8_t address, uint8_t count);
+
+  uint8_t ddram[128];
+  uint8_t cgram[64];
+  uint8_t ac;
+  bool cgramMode;
+  bool eightBit;
+  bool twoLine;
+  bool increment;
+  uint8_t displayControl;
+  unsigned long commands; // command bytes since resetCounts()
+  unsigned long writes;   // data bytes since resetCounts()
+  unsigned long reads;    // bytes read since resetCounts()
+
+private:
+  static void onPin(uint8_t pin, uint8_t value, void *context);
+  void pulse();
+  void read();
+  void drive(uint8_t nibble);
+  void apply(bool rsHigh, uint8_t value);
+  void step(bool forward);
+
+  uint8_t _rs, _rw, _enable;
+  uint8_t _data[4];
+  bool _haveHigh;
+  uint8_t _high;
+  bool _haveReadHigh;
+  uint8_t _read;
+  char _text[129];
+};
+
+#endif
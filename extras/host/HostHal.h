@@ -0,0 +1,24 @@
+#ifndef HostHal_h
+#define HostHal_h
+
+#include <stdint.h>
+
+// What the fake HAL offers host programs beyond the Arduino API: the pin
+// values, the virtual clock, and a hook that sees every digitalWrite().
+namespace hal {
+
+// called after every digitalWrite(); a controller model watches the enable
+// pin with it, and can put data on input pins for the driver to read
+typedef void (*PinHook)(uint8_t pin, uint8_t value, void *context);
+
+extern uint8_t pins[256];
+extern uint8_t modes[256];
+extern unsigned long us;     // the virtual clock; only delays move it
+extern unsigned long writes; // digitalWrite() calls
+
+void setPinHook(PinHook hook, void *context);
+void reset();
+
+} // namespace hal
+
+#endif
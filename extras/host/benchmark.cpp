@@ -0,0 +1,95 @@
+// Runs typical display workloads against the fake HAL and reports, per
+// operation, the simulated bus time (what the display would cost on a real
+// board), the bytes on the bus, the digitalWrite() calls and the host time
+// spent in the driver. Run it under perf or callgrind to see where the
+// driver's own time goes.
+//
+//   lcd_benchmark [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "Controller.h"
+#include "HostHal.h"
+#include "LiquidCrystal.h"
+
+const uint8_t rs = 1, rw = 2, enable = 3;
+const uint8_t d4 = 14, d5 = 15, d6 = 16, d7 = 17;
+
+struct Workload {
+  const char *name;
+  void (*run)(LiquidCrystal &lcd, uint8_t *frame, long i);
+};
+
+static void printNumber(LiquidCrystal &lcd, uint8_t *, long i) {
+  lcd.setCursor(0, 1);
+  lcd.print(i);
+}
+
+static void printLine(LiquidCrystal &lcd, uint8_t *, long) {
+  lcd.setCursor(0, 0);
+  lcd.print("Temperature 21C ");
+}
+
+static void drawFrameOneValue(LiquidCrystal &lcd, uint8_t *frame, long i) {
+  frame[12] = '0' + i % 10;
+  frame[13] = '0' + i / 10 % 10;
+  lcd.drawFrame(frame);
+}
+
+static void drawFrameFull(LiquidCrystal &lcd, uint8_t *frame, long i) {
+  memset(frame, 'a' + i % 26, 32);
+  lcd.drawFrame(frame);
+}
+
+static void createChar(LiquidCrystal &lcd, uint8_t *, long i) {
+  uint8_t bar[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  bar[i % 8] = 0x1F;
+  lcd.createChar(i % 8, bar);
+}
+
+static const Workload workloads[] = {
+    {"print number", printNumber},
+    {"print line", printLine},
+    {"drawFrame 2 cells", drawFrameOneValue},
+    {"drawFrame all", drawFrameFull},
+    {"createChar", createChar},
+};
+
+int main(int argc, char **argv) {
+  long iterations = (argc > 1) ? atol(argv[1]) : 10000;
+
+  printf("%-20s %12s %8s %10s %10s\n", "workload", "bus us/op", "bytes/op",
+         "writes/op", "host ns/op");
+  for (size_t w = 0; w < sizeof(workloads) / sizeof(*workloads); w++) {
+    hal::reset();
+    Controller model(rs, rw, enable, d4, d5, d6, d7);
+    LiquidCrystal lcd(rs, enable, d4, d5, d6, d7);
+    lcd.begin(16, 2);
+    uint8_t shadow[32], frame[32];
+    lcd.attachShadow(shadow);
+    memset(frame, ' ', sizeof(frame));
+
+    model.resetCounts();
+    unsigned long busStart = hal::us;
+    unsigned long writesStart = hal::writes;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; i++) {
+      workloads[w].run(lcd, frame, i);
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+    printf("%-20s %12.1f %8.1f %10.1f %10.1f\n", workloads[w].name,
+           (double)(hal::us - busStart) / iterations,
+           (double)(model.commands + model.writes) / iterations,
+           (double)(hal::writes - writesStart) / iterations,
+           elapsed / iterations);
+  }
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include "Arduino.h"
+#include "HostHal.h"
+
+namespace hal {
+
+uint8_t pins[256];
+uint8_t modes[256];
+unsigned long us = 0;
+unsigned long writes = 0;
+
+static PinHook pinHook = 0;
+static void *pinHookContext = 0;
+
+void setPinHook(PinHook hook, void *context) {
+  pinHook = hook;
+  pinHookContext = context;
+}
+
+void reset() {
+  memset(pins, 0, sizeof(pins));
+  memset(modes, INPUT, sizeof(modes));
+  us = 0;
+  writes = 0;
+  pinHook = 0;
+}
+
+} // namespace hal
+
+void pinMode(uint8_t pin, uint8_t mode) { hal::modes[pin] = mode; }
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  hal::pins[pin] = value ? HIGH : LOW;
+  hal::writes++;
+  if (hal::pinHook) {
+    hal::pinHook(pin, hal::pins[pin], hal::pinHookContext);
+  }
+}
+
+int digitalRead(uint8_t pin) { return hal::pins[pin]; }
+
+unsigned long millis() { return hal::us / 1000; }
+
+unsigned long micros() { return hal::us; }
+
+void delay(unsigned long ms) { hal::us += ms * 1000; }
+
+void delayMicroseconds(unsigned int us) { hal::us += us; }
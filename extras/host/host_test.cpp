@@ -0,0 +1,157 @@
+// Unit tests that run natively against the fake HAL, so that sanitizers and
+// debuggers can be used on the driver. The arduino_ci suite in test/ remains
+// the main one; these cover the paths that matter most for speed.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Controller.h"
+#include "HostHal.h"
+#include "LiquidCrystal.h"
+#include "LiquidCrystal_Page.h"
+
+const uint8_t rs = 1, rw = 2, enable = 3;
+const uint8_t d4 = 14, d5 = 15, d6 = 16, d7 = 17;
+
+static int failures = 0;
+
+#define CHECK(condition)                                                       \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      printf("  %s:%d: %s\n", __FILE__, __LINE__, #condition);                \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+#define CHECK_TEXT(expected, actual) CHECK(strcmp((expected), (actual)) == 0)
+
+static void begin() {
+  hal::reset();
+  Controller model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  CHECK(!model.eightBit);
+  CHECK(model.twoLine);
+  CHECK(model.displayControl == LCD_DISPLAYON);
+  CHECK(hal::us >= 50000); // the power-on wait
+}
+
+static void print() {
+  hal::reset();
+  Controller model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  lcd.print("Hello");
+  lcd.setCursor(3, 1);
+  lcd.print(-42);
+  lcd.print(F(" C"));
+  CHECK_TEXT("Hello           ", model.text(0x00, 16));
+  CHECK_TEXT("   -42 C        ", model.text(0x40, 16));
+}
+
+static void drawFrameSendsOnlyChanges() {
+  hal::reset();
+  Controller model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[32], frame[32];
+  lcd.attachShadow(shadow);
+  memcpy(frame, "Temp    21.5 C  Fan on          ", 32);
+  lcd.drawFrame(frame);
+  memcpy(frame, "Temp    22.0 C  Fan on          ", 32);
+  model.resetCounts();
+  lcd.drawFrame(frame);
+  CHECK(model.writes == 3); // "2.0" over the unchanged '.'
+  CHECK(model.commands == 1);
+  CHECK_TEXT("Temp    22.0 C  ", model.text(0x00, 16));
+}
+
+static void pageShow() {
+  hal::reset();
+  Controller model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[32], buffer[32];
+  lcd.attachShadow(shadow);
+  LiquidCrystal_Page page(lcd, buffer, 16, 2);
+  page.setCursor(0, 1);
+  page.print("Menu");
+  page.show();
+  CHECK_TEXT("Menu            ", model.text(0x40, 16));
+}
+
+#if LCD_ENABLE_UTF8
+static void utf8() {
+  hal::reset();
+  Controller model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2, LCD_5x8DOTS, LCD_ROM_A00);
+  lcd.print("21\xC2\xB0" "C");
+  CHECK(model.ddram[2] == 0xDF);
+  CHECK(model.ddram[3] == 'C');
+}
+#endif
+
+#if LCD_ENABLE_RW
+static void verifyRepairs() {
+  hal::reset();
+  Controller model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal lcd(rs, rw, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[32];
+  lcd.attachShadow(shadow);
+  lcd.print("Pump on");
+  model.ddram[2] = '#';
+  CHECK(lcd.verify() == 1);
+  CHECK_TEXT("Pump on", model.text(0x00, 7));
+  lcd.print("!");
+  CHECK(model.ddram[7] == '!');
+}
+#endif
+
+#if LCD_ENABLE_FRAMES
+static void refreshKeepsToBudget() {
+  hal::reset();
+  Controller model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[32], back[32];
+  lcd.attachShadow(shadow);
+  lcd.attachBackBuffer(back);
+  lcd.setFrameRate(0, 1000);
+  lcd.print("A  B  C  D  E  F");
+  int calls = 1;
+  while (!lcd.refresh()) {
+    calls++;
+  }
+  CHECK(calls > 1);
+  CHECK_TEXT("A  B  C  D  E  F", model.text(0x00, 16));
+}
+#endif
+
+int main() {
+  static const struct {
+    const char *name;
+    void (*run)();
+  } tests[] = {
+      {"begin", begin},
+      {"print", print},
+      {"drawFrameSendsOnlyChanges", drawFrameSendsOnlyChanges},
+      {"pageShow", pageShow},
+#if LCD_ENABLE_UTF8
+      {"utf8", utf8},
+#endif
+#if LCD_ENABLE_RW
+      {"verifyRepairs", verifyRepairs},
+#endif
+#if LCD_ENABLE_FRAMES
+      {"refreshKeepsToBudget", refreshKeepsToBudget},
+#endif
+  };
+  for (size_t i = 0; i < sizeof(tests) / sizeof(*tests); i++) {
+    int before = failures;
+    tests[i].run();
+    printf("%s %s\n", failures == before ? "ok  " : "FAIL", tests[i].name);
+  }
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Decodes and compares the bus traces in test/golden.
+
+    scripts/bus_trace.py decode test/golden/print.trace
+    scripts/bus_trace.py diff old/golden test/golden
+
+decode turns the enable pulses of one trace back into HD44780 commands and
+data. diff takes two trace files or two directories of them, for example a
+checkout from before a change and one from after, and reports how many
+bytes each workload sends and how long it keeps the bus busy.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+def read_trace(path):
+    """Returns (wires, us, pulses) where pulses are (us, rs, rw, data)."""
+    wires, total, pulses = 4, 0, []
+    with open(path) as file:
+        for line in file:
+            summary = re.match(r"# (\d)-bit, \d+ pulses, (\d+) us", line)
+            if summary:
+                wires, total = (int(value) for value in summary.groups())
+            elif line.strip() and not line.startswith("#"):
+                us, rs, rw, data = line.split()
+                pulses.append((int(us), int(rs), int(rw), int(data, 16)))
+    return wires, total, pulses
+
+
+def describe(value):
+    """Names a command byte."""
+    if value & 0x80:
+        return "set DDRAM address 0x%02X" % (value & 0x7F)
+    if value & 0x40:
+        return "set CGRAM address 0x%02X" % (value & 0x3F)
+    if value & 0x20:
+        return "function set: %s-bit, %s line%s, 5x%s dots" % (
+            "8" if value & 0x10 else "4", "2" if value & 0x08 else "1",
+            "s" if value & 0x08 else "", "10" if value & 0x04 else "8")
+    if value & 0x10:
+        return "%s %s" % ("shift display" if value & 0x08 else "move cursor",
+                          "right" if value & 0x04 else "left")
+    if value & 0x08:
+        return "display %s, cursor %s, blink %s" % (
+            "on" if value & 0x04 else "off", "on" if value & 0x02 else "off",
+            "on" if value & 0x01 else "off")
+    if value & 0x04:
+        return "entry mode: %s%s" % (
+            "increment" if value & 0x02 else "decrement",
+            ", shift" if value & 0x01 else "")
+    if value & 0x02:
+        return "return home"
+    if value & 0x01:
+        return "clear display"
+    return "no-op"
+
+
+def decode(pulses, wires):
+    """Yields (us, text) for every byte the controller receives."""
+    # a trace that starts with the 0x03 reset nibbles starts in 8-bit mode,
+    # the way the controller powers up
+    eight_bit = wires == 8 or (pulses and pulses[0][1:] == (0, 0, 0x30))
+    high = None
+    for us, rs, rw, data in pulses:
+        if rw:
+            yield us, "read %s" % ("data" if rs else "busy flag/address")
+            continue
+        if not eight_bit:
+            if high is None:
+                high = data & 0xF0
+                continue
+            data, high = high | (data >> 4), None
+        if rs:
+            shown = chr(data) if 0x20 <= data < 0x7F else "."
+            yield us, "data 0x%02X %s" % (data, shown)
+        else:
+            if data & 0xE0 == 0x20:
+                eight_bit = bool(data & 0x10) or wires == 8
+            yield us, "command 0x%02X %s" % (data, describe(data))
+
+
+def cost(path):
+    """Returns the bytes a trace sends and the time it keeps the bus busy."""
+    wires, total, pulses = read_trace(path)
+    return len(list(decode(pulses, wires))), total
+
+
+def traces(path):
+    if os.path.isdir(path):
+        return {name[:-len(".trace")]: os.path.join(path, name)
+                for name in sorted(os.listdir(path))
+                if name.endswith(".trace")}
+    return {os.path.basename(path)[:-len(".trace")]: path}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    commands = parser.add_subparsers(dest="command")
+    decoding = commands.add_parser("decode", help="decode one trace")
+    decoding.add_argument("trace")
+    diffing = commands.add_parser("diff", help="compare two sets of traces")
+    diffing.add_argument("before")
+    diffing.add_argument("after")
+    args = parser.parse_args()
+
+    if args.command == "decode":
+        wires, _, pulses = read_trace(args.trace)
+        for us, text in decode(pulses, wires):
+            print("%10d  %s" % (us, text))
+    elif args.command == "diff":
+        before, after = traces(args.before), traces(args.after)
+        if len(before) == 1 and len(after) == 1:
+            after = {name: path for name in before for path in after.values()}
+        changed = False
+        for name in sorted(set(before) | set(after)):
+            if name not in before or name not in after:
+                print("%-12s only in %s" % (
+                    name, args.before if name in before else args.after))
+                changed = True
+                continue
+            bytes_before, us_before = cost(before[name])
+            bytes_after, us_after = cost(after[name])
+            if (bytes_before, us_before) != (bytes_after, us_after):
+                changed = True
+            print("%-12s %5d -> %5d bytes (%+d)  %7d -> %7d us (%+d)" % (
+                name, bytes_before, bytes_after, bytes_after - bytes_before,
+                us_before, us_after, us_after - us_before))
+        sys.exit(1 if changed else 0)
+    else:
+        parser.print_help()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""Shows what a display mirrored with LiquidCrystal_Mirror is showing.
+
+Reads the mirror packets from a serial port (or a file of captured bytes,
+or - for stdin) and redraws the screen whenever it changes:
+
+    stty -F /dev/ttyUSB0 115200 raw
+    scripts/lcd_mirror.py /dev/ttyUSB0
+
+Custom characters are shown as the digits 0-7 unless --glyphs is given,
+which also prints their bitmaps. A 'K' is sent first on a serial port so
+that the sketch answers with the whole screen straight away.
+"""
+
+import argparse
+import sys
+
+SYNC = 0xA5
+KEYFRAME = ord("K")
+RUN = ord("R")
+GLYPH = ord("G")
+
+
+class Screen:
+    def __init__(self):
+        self.cols = 0
+        self.rows = 0
+        self.cells = []
+        self.glyphs = [[0] * 8 for _ in range(8)]
+
+    def apply(self, kind, payload):
+        """Applies one packet; returns False for one it doesn't know."""
+        if kind == KEYFRAME:
+            self.cols, self.rows = payload[0], payload[1]
+            self.cells = list(payload[2:2 + self.cols * self.rows])
+        elif kind == RUN:
+            first = payload[0]
+            for i, value in enumerate(payload[1:]):
+                if first + i < len(self.cells):
+                    self.cells[first + i] = value
+        elif kind == GLYPH:
+            self.glyphs[payload[0] & 7] = list(payload[1:9])
+        else:
+            return False
+        return True
+
+    def render(self, glyphs=False):
+        lines = ["+" + "-" * self.cols + "+"]
+        for row in range(self.rows):
+            text = ""
+            for value in self.cells[row * self.cols:(row + 1) * self.cols]:
+                if value < 8:
+                    text += str(value)
+                elif 0x20 <= value < 0x7F:
+                    text += chr(value)
+                else:
+                    text += "?"
+            lines.append("|" + text + "|")
+        lines.append(lines[0])
+        if glyphs:
+            for location, rows in enumerate(self.glyphs):
+                bitmap = ["".join("#" if bits & (0x10 >> i) else "."
+                                  for i in range(5)) for bits in rows]
+                lines.append("%d: %s" % (location, " ".join(bitmap)))
+        return "\n".join(lines)
+
+
+def packets(source):
+    """Yields (type, payload) for every intact packet, skipping noise."""
+    buffer = bytearray()
+    while True:
+        data = source.read(1)
+        if not data:
+            return
+        buffer += data
+        while buffer:
+            if buffer[0] != SYNC:
+                del buffer[0]
+                continue
+            if len(buffer) < 3 or len(buffer) < 4 + buffer[2]:
+                break
+            kind, length = buffer[1], buffer[2]
+            payload = bytes(buffer[3:3 + length])
+            check = kind ^ length
+            for value in payload:
+                check ^= value
+            if check != buffer[3 + length]:
+                del buffer[0]  # not a packet after all; look for the next
+                continue
+            del buffer[:4 + length]
+            yield kind, payload
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source", help="serial port, capture file or -")
+    parser.add_argument("--glyphs", action="store_true",
+                        help="also print the custom character bitmaps")
+    args = parser.parse_args()
+
+    if args.source == "-":
+        source = sys.stdin.buffer
+    else:
+        source = open(args.source, "r+b" if args.source.startswith("/dev/")
+                      else "rb", buffering=0)
+        if args.source.startswith("/dev/"):
+            source.write(bytes([KEYFRAME]))
+
+    screen = Screen()
+    for kind, payload in packets(source):
+        if screen.apply(kind, payload) and screen.cols:
+            print(screen.render(args.glyphs), flush=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Turns a binary log written by SensorLog into CSV.
+
+    scripts/sensor_log.py LOG.BIN > log.csv
+    scripts/sensor_log.py --scale 1:0.01 LOG.BIN
+
+Prints one time,channel,value line per record. --scale multiplies the
+values of a channel, for fixed-point readings. Blocks that are damaged are
+skipped up to the next block header, so the rest of the log still decodes.
+"""
+
+import argparse
+import sys
+
+SYNC = 0xA5
+BLOCK = ord("L")
+HEADER = 8
+PAD = 0xFF
+
+
+def varint(data, offset):
+    """Returns (value, offset after it); raises IndexError past the end."""
+    value, shift = 0, 0
+    while True:
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, offset
+
+
+def records(data):
+    """Yields (time, channel, value) for every record, skipping bad blocks."""
+    offset = 0
+    while offset + HEADER <= len(data):
+        if data[offset] != SYNC or data[offset + 1] != BLOCK:
+            offset += 1
+            continue
+        size = data[offset + 2] | data[offset + 3] << 8
+        time = int.from_bytes(data[offset + 4:offset + 8], "little")
+        block = data[offset:offset + size]
+        if size <= HEADER or len(block) < size:
+            offset += 1  # not a block header after all
+            continue
+        last, position, decoded = {}, HEADER, []
+        try:
+            while position < size and block[position] != PAD:
+                channel = block[position]
+                delta, position = varint(block, position + 1)
+                change, position = varint(block, position)
+                change = (change >> 1) ^ -(change & 1)
+                time = (time + delta) & 0xFFFFFFFF
+                value = last.get(channel, 0) + change
+                value = (value + 2**31) % 2**32 - 2**31
+                last[channel] = value
+                decoded.append((time, channel, value))
+        except IndexError:
+            offset += 1
+            continue
+        for record in decoded:
+            yield record
+        offset += size
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="log file, or - for stdin")
+    parser.add_argument("--scale", action="append", default=[],
+                        metavar="CHANNEL:FACTOR",
+                        help="multiply a channel's values by FACTOR")
+    args = parser.parse_args()
+
+    scales = {}
+    for scale in args.scale:
+        channel, factor = scale.split(":")
+        scales[int(channel)] = float(factor)
+
+    if args.log == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.log, "rb") as file:
+            data = file.read()
+
+    print("time,channel,value")
+    for time, channel, value in records(data):
+        if channel in scales:
+            value = "%g" % (value * scales[channel])
+        print("%d,%d,%s" % (time, channel, value))
+
+
+if __name__ == "__main__":
+    main()
@@ -23,12 +23,15 @@
 // can't assume that it's in that state when a sketch starts (and the
 // LiquidCrystal constructor is called).
 
+#if LCD_ENABLE_8BIT
+#if LCD_ENABLE_RW
 LiquidCrystal_Base::LiquidCrystal_Base(uint8_t rs, uint8_t rw, uint8_t enable,
                                        uint8_t d0, uint8_t d1, uint8_t d2,
                                        uint8_t d3, uint8_t d4, uint8_t d5,
                                        uint8_t d6, uint8_t d7) {
   init(0, rs, rw, enable, d0, d1, d2, d3, d4, d5, d6, d7);
 }
+#endif
 
 LiquidCrystal_Base::LiquidCrystal_Base(uint8_t rs, uint8_t enable, uint8_t d0,
                                        uint8_t d1, uint8_t d2, uint8_t d3,
@@ -36,12 +39,15 @@ LiquidCrystal_Base::LiquidCrystal_Base(uint8_t rs, uint8_t enable, uint8_t d0,
                                        uint8_t d7) {
   init(0, rs, 255, enable, d0, d1, d2, d3, d4, d5, d6, d7);
 }
+#endif
 
+#if LCD_ENABLE_RW
 LiquidCrystal_Base::LiquidCrystal_Base(uint8_t rs, uint8_t rw, uint8_t enable,
                                        uint8_t d0, uint8_t d1, uint8_t d2,
                                        uint8_t d3) {
   init(1, rs, rw, enable, d0, d1, d2, d3, 0, 0, 0, 0);
 }
+#endif
 
 LiquidCrystal_Base::LiquidCrystal_Base(uint8_t rs, uint8_t enable, uint8_t d0,
                                        uint8_t d1, uint8_t d2, uint8_t d3) {
@@ -53,17 +59,61 @@ void LiquidCrystal_Base::init(uint8_t fourbitmode, uint8_t rs, uint8_t rw,
                               uint8_t d2, uint8_t d3, uint8_t d4, uint8_t d5,
                               uint8_t d6, uint8_t d7) {
   _rs_pin = rs;
+#if LCD_ENABLE_RW
   _rw_pin = rw;
+#else
+  (void)rw;
+#endif
   _enable_pin = enable;
 
   _data_pins[0] = d0;
   _data_pins[1] = d1;
   _data_pins[2] = d2;
   _data_pins[3] = d3;
+#if LCD_ENABLE_8BIT
   _data_pins[4] = d4;
   _data_pins[5] = d5;
   _data_pins[6] = d6;
   _data_pins[7] = d7;
+#else
+  (void)d4, (void)d5, (void)d6, (void)d7;
+  fourbitmode = 1;
+#endif
+
+  _address = 0;
+  _shadow = NULL;
+  _back = NULL;
+  _dirty = NULL;
+  _skip_unchanged = false;
+  _skipped = false;
+#if LCD_ENABLE_FRAMES
+  _frame_interval = 0;
+  _frame_budget = 0;
+  _frame_start = 0;
+  _frame_cell = 0xFFFF;
+  _urgent_count = 0;
+#endif
+#if LCD_ENABLE_CGRAM
+  _cgram_used = 0;
+  _cgram_cache = NULL;
+  _cgram_dirty = 0;
+#endif
+#if LCD_ENABLE_UTF8 && LCD_ENABLE_CGRAM
+  _glyphs = NULL;
+  _glyph_count = 0;
+  _glyph_slots = 0;
+  _glyph_owned = 0;
+  _glyph_next = 0;
+#endif
+#if LCD_ENABLE_IDLE
+  _idle_hook = NULL;
+  _idle_threshold = 0;
+#endif
+
+#if LCD_ENABLE_TIMING
+  LiquidCrystal_Timing timing = LCD_TIMING;
+  _timing = timing;
+#endif
 
   if (fourbitmode)
     _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
@@ -73,16 +123,32 @@ void LiquidCrystal_Base::init(uint8_t fourbitmode, uint8_t rs, uint8_t rw,
   begin(16, 1);
 }
 
-void LiquidCrystal_Base::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) {
-  if (lines > 1) {
+void LiquidCrystal_Base::begin(uint8_t cols, uint8_t lines, uint8_t dotsize,
+                               uint8_t rom) {
+#ifndef LCD_FIXED_COLS
+  _cols = cols;
+#else
+  (void)cols;
+#endif
+#ifndef LCD_FIXED_ROWS
+  _numlines = lines;
+#else
+  (void)lines;
+#endif
+  if (_numlines > 1) {
     _displayfunction |= LCD_2LINE;
   }
-  _numlines = lines;
+#if LCD_ENABLE_UTF8
+  _rom = rom;
+  _utf8.pending = 0;
+#else
+  (void)rom;
+#endif
 
-  setRowOffsets(0x00, 0x40, 0x00 + cols, 0x40 + cols);
+  setRowOffsets(0x00, 0x40, 0x00 + _cols, 0x40 + _cols);
 
   // for some 1 line displays you can select a 10 pixel high font
-  if ((dotsize != LCD_5x8DOTS) && (lines == 1)) {
+  if ((dotsize != LCD_5x8DOTS) && (_numlines == 1)) {
     _displayfunction |= LCD_5x10DOTS;
   }
 
@@ -95,7 +161,7 @@ void LiquidCrystal_Base::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) {
 
   // Do these once, instead of every time a character is drawn for speed
   // reasons.
-  for (int i = 0; i < ((_displayfunction & LCD_8BITMODE) ? 8 : 4); ++i) {
+  for (int i = 0; i < (eightBit() ? 8 : 4); ++i) {
     pinMode(_data_pins[i], OUTPUT);
   }
 
@@ -103,7 +169,7 @@ void LiquidCrystal_Base::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) {
   // according to datasheet, we need at least 40 ms after power rises above 2.7
   // V before sending commands. Arduino can turn on way before 4.5 V so we'll
   // wait 50
-  delayMicroseconds(50000);
+  wait(50000);
   // Now we pull both RS and R/W low to begin commands
   digitalWrite(_rs_pin, LOW);
   digitalWrite(_enable_pin, LOW);
@@ -112,17 +178,17 @@ void LiquidCrystal_Base::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) {
   }
 
   // put the LCD into 4 bit or 8 bit mode
-  if (!(_displayfunction & LCD_8BITMODE)) {
+  if (!eightBit()) {
     // this is according to the Hitachi HD44780 datasheet
     // figure 24, pg 46
 
     // we start in 8bit mode, try to set 4 bit mode
     write4bits(0x03);
-    delayMicroseconds(4500); // wait min 4.1ms
+    wait(4500); // wait min 4.1ms
 
     // second try
     write4bits(0x03);
-    delayMicroseconds(4500); // wait min 4.1ms
+    wait(4500); // wait min 4.1ms
 
     // third go!
     write4bits(0x03);
@@ -136,7 +202,7 @@ void LiquidCrystal_Base::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) {
 
     // Send function set command sequence
     command(LCD_FUNCTIONSET | _displayfunction);
-    delayMicroseconds(4500); // wait more than 4.1 ms
+    wait(4500); // wait more than 4.1 ms
 
     // second try
     command(LCD_FUNCTIONSET | _displayfunction);
@@ -162,6 +228,71 @@ void LiquidCrystal_Base::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) {
   command(LCD_ENTRYMODESET | _displaymode);
 }
 
+// Brings a display whose controller lost track of the interface, say after a
+// glitch on the enable line put 4-bit mode half a byte out of step, back to
+// what the sketch last sent. Unlike begin() it skips the power-on wait and
+// doesn't clear: it resets the interface the way begin() does, sends the
+// function set, display control and entry mode again, reloads CGRAM from the
+// char cache and the display from the shadow, and puts the cursor back.
+// With an RW pin only the cells that came out wrong are rewritten. Cheap
+// enough to call every few seconds.
+void LiquidCrystal_Base::resync() {
+  digitalWrite(_rs_pin, LOW);
+  digitalWrite(_enable_pin, LOW);
+  if (_rw_pin != 255) {
+    digitalWrite(_rw_pin, LOW);
+  }
+
+  if (!eightBit()) {
+    // the first nibble may finish a half-sent byte, in the worst case a
+    // return home; after three the controller is in 8-bit mode either way
+    write4bits(0x03);
+    wait(_timing.clear);
+    write4bits(0x03);
+    write4bits(0x03);
+    write4bits(0x02);
+  }
+  command(LCD_FUNCTIONSET | _displayfunction);
+  command(LCD_DISPLAYCONTROL | _displaycontrol);
+  // CGRAM and the display are reloaded left to right, whatever the sketch's
+  // own entry mode; endRun() sends that at the end
+  uint8_t mode = _displaymode;
+  _displaymode = LCD_ENTRYLEFT;
+  command(LCD_ENTRYMODESET | LCD_ENTRYLEFT);
+
+  uint8_t address = _address;
+#if LCD_ENABLE_CGRAM
+  if (_cgram_cache) {
+    command(LCD_SETCGRAMADDR);
+    setMode(HIGH);
+    for (uint8_t i = 0; i < 64; i++) {
+      sendBits(_cgram_cache[i]);
+#ifdef MOCK_PINS_COUNT
+      sent(_cgram_cache[i], HIGH);
+#endif
+    }
+  }
+#endif
+#if LCD_ENABLE_RW
+  if (_shadow && _rw_pin != 255) {
+    verify();
+  } else
+#endif
+  if (_shadow) {
+    uint8_t rows = (_numlines < 4) ? _numlines : 4;
+    for (uint8_t row = 0; row < rows; row++) {
+      setAddress(0, row);
+      setMode(HIGH);
+      for (uint8_t col = 0; col < _cols; col++) {
+        putChar(_shadow[row * _cols + col]);
+      }
+    }
+  }
+  endRun(mode);
+  _address = address;
+  restoreAddress();
+}
+
 void LiquidCrystal_Base::setRowOffsets(int row0, int row1, int row2, int row3) {
   _row_offsets[0] = row0;
   _row_offsets[1] = row1;
@@ -171,13 +302,33 @@ void LiquidCrystal_Base::setRowOffsets(int row0, int row1, int row2, int row3) {
 
 /********** high level commands, for the user! */
 void LiquidCrystal_Base::clear() {
+  _address = 0;
+  if (_back) {
+    memset(_back, ' ', _cols * _numlines);
+    return;
+  }
   command(LCD_CLEARDISPLAY); // clear display, set cursor position to zero
-  delayMicroseconds(2000);   // this command takes a long time!
+  wait(_timing.clear);       // this command takes a long time!
+  // the controller also goes back to incrementing the address
+  _displaymode |= LCD_ENTRYLEFT;
+  if (_shadow) {
+    uint16_t cells = _dirty ? _cols * ((_numlines < 4) ? _numlines : 4) : 0;
+    for (uint16_t cell = 0; cell < cells; cell++) {
+      if (_shadow[cell] != ' ') {
+        _dirty[cell >> 3] |= 1 << (cell & 7);
+      }
+    }
+    memset(_shadow, ' ', _cols * _numlines);
+  }
 }
 
 void LiquidCrystal_Base::home() {
+  _address = 0;
+  if (_back) {
+    return;
+  }
   command(LCD_RETURNHOME); // set cursor position to zero
-  delayMicroseconds(2000); // this command takes a long time!
+  wait(_timing.clear);     // this command takes a long time!
 }
 
 void LiquidCrystal_Base::setCursor(uint8_t col, uint8_t row) {
@@ -189,7 +340,248 @@ void LiquidCrystal_Base::setCursor(uint8_t col, uint8_t row) {
     row = _numlines - 1; // we count rows starting w/ 0
   }
 
-  command(LCD_SETDDRAMADDR | (col + _row_offsets[row]));
+  _address = (col + _row_offsets[row]) & 0x7F;
+  if (!_back) {
+    command(LCD_SETDDRAMADDR | (col + _row_offsets[row]));
+  }
+}
+
+// Keeps a copy of what is on the display in `shadow`, a buffer of cols x
+// rows bytes for the geometry given to begin(). The display is cleared so
+// that the copy starts out right. Pass NULL to stop.
+void LiquidCrystal_Base::attachShadow(uint8_t *shadow) {
+  _shadow = shadow;
+  if (_shadow) {
+    clear();
+  }
+}
+
+// Makes text printed straight to the display skip the cells that already
+// show the same character, going by the shadow; the address is only set
+// again before the next character that differs. Sketches that print the
+// same labels every time through loop() get most of the savings of
+// drawFrame() that way, and print() still takes effect at once. Cells are
+// never skipped while the cursor shows or autoscroll is on.
+void LiquidCrystal_Base::skipUnchanged(bool skip) {
+  _skip_unchanged = skip;
+  if (!skip && _skipped) {
+    restoreAddress();
+  }
+}
+
+#if LCD_ENABLE_CGRAM
+// Keeps a copy of CGRAM in `cache`, 64 bytes, for resync() to reload. Attach
+// it before the createChar() calls; locations defined earlier read as blank.
+void LiquidCrystal_Base::attachCharCache(uint8_t *cache) {
+  _cgram_cache = cache;
+  if (_cgram_cache) {
+    memset(_cgram_cache, 0, 64);
+  }
+}
+#endif
+
+// Brings the display to `frame`, a cols x rows buffer laid out like the
+// shadow. With a shadow attached only the runs of cells that differ are
+// sent; without one everything is. With a back buffer the frame just goes
+// there, for refresh() to send.
+void LiquidCrystal_Base::drawFrame(const uint8_t *frame) {
+  if (_back) {
+    memcpy(_back, frame, _cols * _numlines);
+    return;
+  }
+  bool sent;
+  flush(frame, 0, 0, sent);
+}
+
+// Sends the cells of `frame` that differ from the shadow (all of them
+// without one) from position `from` on, where positions count the visible
+// cells in DDRAM address order. Rows that continue each other's addresses,
+// like rows 0 and 2 of a 20x4 display, are one run, and a dirty run goes on
+// over up to LCD_ADDRESS_COST unchanged cells rather than set the address
+// again. Once `budget` us have passed, it stops before the next cell it
+// would send, even in the middle of a run. Returns the position it stopped
+// at, or the number of cells when done.
+uint16_t LiquidCrystal_Base::flush(const uint8_t *frame, uint16_t from,
+                                   uint16_t budget, bool &sent) {
+  uint8_t rows = (_numlines < 4) ? _numlines : 4;
+  uint8_t order[4];
+  for (uint8_t row = 0; row < rows; row++) {
+    uint8_t slot = row;
+    while (slot > 0 && _row_offsets[order[slot - 1]] > _row_offsets[row]) {
+      order[slot] = order[slot - 1];
+      slot--;
+    }
+    order[slot] = row;
+  }
+
+  unsigned long start = micros();
+  uint16_t cells = _cols * rows;
+  Run run;
+  startRun(run);
+  uint16_t position;
+  for (position = from; position < cells; position++) {
+    uint8_t row = order[position / _cols];
+    uint8_t col = position % _cols;
+    uint16_t cell = row * _cols + col;
+    bool changed = !_shadow || _shadow[cell] != frame[cell];
+    if (changed && run.sent && budget && micros() - start >= budget) {
+      break;
+    }
+    runCell(run, (col + _row_offsets[row]) & 0x7F, frame[cell], changed);
+  }
+  endRun(run.mode);
+  sent = run.sent;
+  return position;
+}
+
+// Makes text go to `back`, a cols x rows buffer like the shadow, instead of
+// straight to the display, so a sketch can print as often as it likes and
+// refresh() sends only the final state, at most at the frame rate. Clearing
+// and moving the cursor only happen in the buffer as well; CGRAM and the
+// display settings are still sent at once. Pass NULL to write straight
+// through again, after refresh() has returned true.
+void LiquidCrystal_Base::attachBackBuffer(uint8_t *back) {
+  _back = back;
+#if LCD_ENABLE_FRAMES
+  _frame_cell = 0xFFFF;
+#endif
+  if (_back && _shadow) {
+    memcpy(_back, _shadow, _cols * _numlines);
+  } else if (_back) {
+    memset(_back, ' ', _cols * _numlines);
+  } else {
+    restoreAddress(); // the cursor only moved in the buffer
+  }
+}
+
+#if LCD_ENABLE_FRAMES
+// Limits refresh() to `fps` frames a second, and each call to about `budget`
+// us, 0 for no limit. A frame that doesn't fit is finished by the next calls,
+// so a full redraw is spread over several passes of loop().
+void LiquidCrystal_Base::setFrameRate(uint8_t fps, uint16_t budget) {
+  _frame_interval = fps ? 1000000UL / fps : 0;
+  _frame_budget = budget;
+}
+
+// Marks cells of the back buffer that refresh() sends before anything
+// else: at every call, whether or not a frame is due, and ahead of the rest
+// of an unfinished frame. An alarm printed into a region shows
+// after one refresh(), however much routine redrawing is queued. Needs a
+// shadow. Returns false when LCD_URGENT_REGIONS are already marked or the
+// region is off the display; it is cut at the end of the row.
+bool LiquidCrystal_Base::setUrgent(uint8_t col, uint8_t row, uint8_t width) {
+  if (_urgent_count >= LCD_URGENT_REGIONS || col >= _cols ||
+      row >= ((_numlines < 4) ? _numlines : 4)) {
+    return false;
+  }
+  _urgent_col[_urgent_count] = col;
+  _urgent_row[_urgent_count] = row;
+  _urgent_width[_urgent_count] = (width < _cols - col) ? width : _cols - col;
+  _urgent_count++;
+  return true;
+}
+
+// Marks a field of a layout as urgent.
+bool LiquidCrystal_Base::setUrgent(const LiquidCrystal_Item *item) {
+  return setUrgent(pgm_read_byte(&item->col), pgm_read_byte(&item->row),
+                   pgm_read_byte(&item->width));
+}
+
+void LiquidCrystal_Base::clearUrgent() { _urgent_count = 0; }
+
+// Sends the cells of the urgent regions that differ from the shadow, one run
+// per region from the first changed cell to the last. Returns true if it
+// sent anything.
+bool LiquidCrystal_Base::flushUrgent() {
+  bool sent = false;
+  uint8_t mode = _displaymode;
+  for (uint8_t i = 0; _shadow && i < _urgent_count; i++) {
+    uint16_t start = _urgent_row[i] * _cols;
+    uint8_t first = _urgent_col[i];
+    uint8_t end = first + _urgent_width[i];
+    while (first < end && _shadow[start + first] == _back[start + first]) {
+      first++;
+    }
+    while (end > first && _shadow[start + end - 1] == _back[start + end - 1]) {
+      end--;
+    }
+    if (first == end) {
+      continue;
+    }
+    if (!sent) {
+      mode = beginRun();
+    }
+    setAddress(first, _urgent_row[i]);
+    setMode(HIGH);
+    while (first < end) {
+      putChar(_back[start + first++]);
+    }
+    sent = true;
+  }
+  endRun(mode);
+  return sent;
+}
+#endif
+
+// Sends the cells of the back buffer that differ from the shadow, in runs.
+// Call it every time through loop(). The urgent regions go out straight
+// away; the rest waits until the next frame is due, and stops once it has
+// used up its budget. Returns true when it has finished a frame.
+bool LiquidCrystal_Base::refresh() {
+  if (!_back) {
+    return true;
+  }
+  uint8_t address = _address;
+#if LCD_ENABLE_FRAMES
+  bool urgent = flushUrgent();
+  unsigned long now = micros();
+  if (_frame_cell == 0xFFFF) {
+    if (now - _frame_start < _frame_interval) {
+      _address = address;
+      if (urgent) {
+        restoreAddress();
+      }
+      return false;
+    }
+    _frame_start = now;
+    _frame_cell = 0;
+  }
+
+  uint16_t cells = _cols * ((_numlines < 4) ? _numlines : 4);
+  bool sent;
+  uint16_t cell = flush(_back, _frame_cell, _frame_budget, sent);
+  _address = address;
+  if (sent || urgent) {
+    restoreAddress(); // where the cursor shows
+  }
+
+  if (cell < cells) {
+    _frame_cell = cell;
+    return false;
+  }
+  _frame_cell = 0xFFFF;
+#else
+  bool sent;
+  flush(_back, 0, 0, sent);
+  _address = address;
+  if (sent) {
+    restoreAddress();
+  }
+#endif
+  return true;
+}
+
+// Moves to a field of a flash-resident screen.
+void LiquidCrystal_Base::setCursor(const LiquidCrystal_Field *field) {
+  setCursor(pgm_read_byte(&field->col), pgm_read_byte(&field->row));
+}
+
+// Moves to an item of a layout, with the address the compiler worked out.
+void LiquidCrystal_Base::setCursor(const LiquidCrystal_Item *item) {
+  _address = pgm_read_byte(&item->address);
+  if (!_back) {
+    command(LCD_SETDDRAMADDR | _address);
+  }
 }
 
 // Turn the display on/off (quickly)
@@ -254,51 +646,603 @@ void LiquidCrystal_Base::noAutoscroll(void) {
   command(LCD_ENTRYMODESET | _displaymode);
 }
 
+#if LCD_ENABLE_CGRAM
 // Allows us to fill the first 8 CGRAM locations
 // with custom characters
 void LiquidCrystal_Base::createChar(uint8_t location, uint8_t charmap[]) {
   location &= 0x7; // we only have 8 locations 0-7
+  _cgram_used |= 1 << location;
+  _address = 0x80 | (location << 3);
   command(LCD_SETCGRAMADDR | (location << 3));
   for (int i = 0; i < 8; i++) {
-    write(charmap[i]);
+    sendChar(charmap[i]);
+  }
+}
+
+// Hands out a CGRAM location nobody has written or reserved yet, so that
+// helpers which draw with custom characters can share the 8 locations with
+// each other and with the sketch's own createChar() calls.
+uint8_t LiquidCrystal_Base::reserveChar() {
+  for (uint8_t location = 0; location < 8; location++) {
+    if (!(_cgram_used & (1 << location))) {
+      _cgram_used |= 1 << location;
+      return location;
+    }
   }
+  return LCD_NOCHAR;
+}
+
+void LiquidCrystal_Base::releaseChar(uint8_t location) {
+  _cgram_used &= ~(1 << (location & 0x7));
 }
+#endif
 
 /*********** mid level commands, for sending data/cmds */
 
-inline void LiquidCrystal_Base::command(uint8_t value) { send(value, LOW); }
+void LiquidCrystal_Base::command(uint8_t value) {
+  if (value < LCD_ENTRYMODESET || value >= LCD_SETCGRAMADDR) {
+    _skipped = false; // these set the address counter themselves
+  } else if (_skipped) {
+    restoreAddress(); // the rest act where the cursor should be
+  }
+  send(value, LOW);
+}
 
 inline size_t LiquidCrystal_Base::write(uint8_t value) {
-  send(value, HIGH);
+  if (translate(value)) {
+    sendChar(value);
+  }
   return 1; // assume success
 }
 
+// Sends a character code as it is, never translated: a CGRAM location, or
+// a ROM code that other code has already picked.
+size_t LiquidCrystal_Base::writeRaw(uint8_t code) {
+  sendChar(code);
+  return 1;
+}
+
+// Sends a whole buffer with RS raised once rather than once per character.
+// Translated text goes character by character, since loading a glyph
+// sends commands in between.
+size_t LiquidCrystal_Base::write(const uint8_t *buffer, size_t size) {
+  if (translating()) {
+    return Print::write(buffer, size);
+  }
+  setMode(HIGH);
+  for (size_t i = 0; i < size; i++) {
+    pushChar(buffer[i]);
+  }
+  return size;
+}
+
+// Writes like write(), but skips the cells that already show the same
+// character, as skipUnchanged() does for all text. Needs a shadow.
+size_t LiquidCrystal_Base::writeChanged(const uint8_t *buffer, size_t size) {
+  bool skip = _skip_unchanged;
+  _skip_unchanged = true;
+  size = write(buffer, size);
+  _skip_unchanged = skip;
+  return size;
+}
+
+// Writes from (col, row) leftwards, the way right-to-left text reads: the
+// first character at col and each next one to the left of it. The entry
+// mode is switched once for the run and put back afterwards, so the run
+// takes one address set, and the cursor ends up left of the last character.
+size_t LiquidCrystal_Base::writeRTL(uint8_t col, uint8_t row,
+                                    const uint8_t *buffer, size_t size) {
+  uint8_t mode = _displaymode;
+  setEntryMode(LCD_ENTRYRIGHT | LCD_ENTRYSHIFTDECREMENT);
+  setCursor(col, row);
+  size = write(buffer, size);
+  setEntryMode(mode);
+  return size;
+}
+
+// Prints a number right-aligned with its last digit at (col, row), padded
+// on the left with spaces to `width` so it covers a longer one shown there
+// before. With `decimals`, the value is fixed-point and a decimal point goes
+// before that many digits. A value too long for `width` fills it with '#'
+// instead, leaving the cells on its left alone. The digits come out least
+// significant first, in one right-to-left run, so no buffer of the text is
+// needed.
+size_t LiquidCrystal_Base::printRight(uint8_t col, uint8_t row, long value,
+                                      uint8_t width, uint8_t decimals) {
+  uint8_t mode = _displaymode;
+  setEntryMode(LCD_ENTRYRIGHT | LCD_ENTRYSHIFTDECREMENT);
+  setCursor(col, row);
+  unsigned long magnitude = (value < 0) ? 0UL - value : value;
+  size_t n = 0;
+  uint8_t digits = 0;
+  if (width) {
+    unsigned long rest = magnitude;
+    do {
+      rest /= 10;
+      digits++;
+    } while (rest || digits <= decimals);
+    digits += (value < 0) + (decimals ? 1 : 0);
+    if (digits > width) {
+      while (n < width) {
+        n += write('#');
+      }
+      setEntryMode(mode);
+      return n;
+    }
+    digits = 0;
+  }
+  do {
+    n += write('0' + magnitude % 10);
+    magnitude /= 10;
+    if (++digits == decimals) {
+      n += write('.');
+    }
+  } while (magnitude || digits <= decimals);
+  if (value < 0) {
+    n += write('-');
+  }
+  while (n < width) {
+    n += write(' ');
+  }
+  setEntryMode(mode);
+  return n;
+}
+
+// Streams a string straight from flash, without copying it to RAM first.
+size_t LiquidCrystal_Base::print(const __FlashStringHelper *text) {
+  PGM_P p = reinterpret_cast<PGM_P>(text);
+  size_t n = 0;
+  if (translating()) {
+    for (uint8_t c; (c = pgm_read_byte(p + n)); n++) {
+      write(c);
+    }
+    return n;
+  }
+  setMode(HIGH);
+  for (uint8_t c; (c = pgm_read_byte(p + n)); n++) {
+    pushChar(c);
+  }
+  return n;
+}
+
+// Replaces everything on the display with a flash-resident screen: rows of
+// text separated by '\n'. Each row goes out as one run, cut or padded with
+// spaces to the width of the display, and rows the screen doesn't have are
+// blanked, so no clear() is needed beforehand. The rows go left to right
+// whatever the entry mode.
+void LiquidCrystal_Base::drawScreen(const __FlashStringHelper *screen) {
+  PGM_P p = reinterpret_cast<PGM_P>(screen);
+  uint8_t mode = _displaymode;
+  setEntryMode(LCD_ENTRYLEFT);
+  for (uint8_t row = 0; row < _numlines; row++) {
+    setCursor(0, row);
+    setMode(HIGH);
+    uint8_t col = 0;
+    uint8_t c;
+    while ((c = pgm_read_byte(p)) && c != '\n') {
+      p++;
+      if (col < _cols && translate(c)) {
+        if (translating()) {
+          sendChar(c); // a glyph may have been loaded in between
+        } else {
+          pushChar(c);
+        }
+        col++;
+      }
+    }
+    if (c == '\n') {
+      p++;
+    }
+    if (translating()) {
+      setMode(HIGH);
+    }
+    for (; col < _cols; col++) {
+      pushChar(' ');
+    }
+  }
+  setEntryMode(mode);
+}
+
+// Draws a layout: the text of every text item and blanks over every field.
+// An item that starts where the previous one ended goes on in the same run;
+// cells no item covers are left alone. The items go left to right whatever
+// the entry mode.
+void LiquidCrystal_Base::drawLayout(const LiquidCrystal_Item *items,
+                                    uint8_t count) {
+  uint8_t mode = _displaymode;
+  setEntryMode(LCD_ENTRYLEFT);
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t address = pgm_read_byte(&items[i].address);
+    uint8_t width = pgm_read_byte(&items[i].width);
+    PGM_P text = reinterpret_cast<PGM_P>(pgm_read_ptr(&items[i].text));
+    if (address != _address) {
+      _address = address;
+      if (!_back) {
+        command(LCD_SETDDRAMADDR | address);
+      }
+    }
+    setMode(HIGH);
+    for (uint8_t n = 0; n < width; n++) {
+      pushChar(text ? pgm_read_byte(text + n) : ' ');
+    }
+  }
+  setEntryMode(mode);
+}
+
+// write one character code, keeping track of where the controller's address
+// counter moves to
+void LiquidCrystal_Base::sendChar(uint8_t value) {
+  setMode(HIGH);
+  pushChar(value);
+}
+
+// the data part of sendChar(), for runs that have already raised RS; text
+// only goes as far as the back buffer if there is one, and skips what the
+// display already shows with skipUnchanged()
+void LiquidCrystal_Base::pushChar(uint8_t value) {
+  if (_back && !(_address & 0x80)) {
+    int16_t cell = cellAt(_address);
+    if (cell >= 0) {
+      _back[cell] = value;
+    }
+    stepAddress();
+    return;
+  }
+  if (_skip_unchanged && _shadow && !(_address & 0x80) &&
+      !(_displaymode & LCD_ENTRYSHIFTINCREMENT) &&
+      !(_displaycontrol & (LCD_CURSORON | LCD_BLINKON))) {
+    int16_t cell = cellAt(_address);
+    if (cell >= 0 && _shadow[cell] == value) {
+      stepAddress();
+      _skipped = true;
+      return;
+    }
+  }
+  if (_skipped) {
+    restoreAddress();
+    setMode(HIGH);
+  }
+  putChar(value);
+}
+
+// the part of pushChar() that goes on the bus
+void LiquidCrystal_Base::putChar(uint8_t value) {
+  sendBits(value);
+#ifdef MOCK_PINS_COUNT
+  sent(value, HIGH);
+#endif
+  if (_address & 0x80) {
+#if LCD_ENABLE_CGRAM
+    if (_cgram_cache) {
+      _cgram_cache[_address & 0x3F] = value;
+    }
+    _cgram_dirty |= 1 << ((_address >> 3) & 0x7);
+#endif
+  } else if (_shadow) {
+    int16_t cell = cellAt(_address);
+    if (cell >= 0) {
+      if (_dirty && _shadow[cell] != value) {
+        _dirty[cell >> 3] |= 1 << (cell & 7);
+      }
+      _shadow[cell] = value;
+    }
+  }
+  stepAddress();
+}
+
+// index into a cols x rows buffer of the cell a DDRAM address is shown in,
+// or -1 if it is off the display
+int16_t LiquidCrystal_Base::cellAt(uint8_t address) {
+  uint8_t rows = (_numlines < 4) ? _numlines : 4;
+  for (uint8_t row = 0; row < rows; row++) {
+    if (address >= _row_offsets[row] && address < _row_offsets[row] + _cols) {
+      return row * _cols + address - _row_offsets[row];
+    }
+  }
+  return -1;
+}
+
 /************ low level data pushing commands **********/
 
+// send our copy of the address counter back to the controller, after
+// something else has moved its address counter
+void LiquidCrystal_Base::restoreAddress() {
+  if (_address & 0x80) {
+    command(LCD_SETCGRAMADDR | (_address & 0x3F));
+  } else {
+    command(LCD_SETDDRAMADDR | _address);
+  }
+}
+
+// setCursor() that goes to the display even with a back buffer
+void LiquidCrystal_Base::setAddress(uint8_t col, uint8_t row) {
+  _address = (col + _row_offsets[row]) & 0x7F;
+  command(LCD_SETDDRAMADDR | _address);
+}
+
+// Changes the entry mode for a run of text. With a back buffer nothing is
+// sent: there the mode only steers where the characters go in the buffer,
+// and flush() sets its own.
+void LiquidCrystal_Base::setEntryMode(uint8_t mode) {
+  if (mode != _displaymode) {
+    _displaymode = mode;
+    if (!_back) {
+      command(LCD_ENTRYMODESET | _displaymode);
+    }
+  }
+}
+
 // write either command or data, with automatic 4/8-bit selection
 void LiquidCrystal_Base::send(uint8_t value, uint8_t mode) {
+  setMode(mode);
+  sendBits(value);
+#ifdef MOCK_PINS_COUNT
+  sent(value, mode);
+#endif
+}
+
+// select command (LOW) or data (HIGH) writes for the bytes that follow
+void LiquidCrystal_Base::setMode(uint8_t mode) {
   digitalWrite(_rs_pin, mode);
 
   // if there is a RW pin indicated, set it low to Write
   if (_rw_pin != 255) {
     digitalWrite(_rw_pin, LOW);
   }
+}
 
-  if (_displayfunction & LCD_8BITMODE) {
+void LiquidCrystal_Base::sendBits(uint8_t value) {
+#if LCD_ENABLE_8BIT
+  if (eightBit()) {
     write8bits(value);
+    return;
+  }
+#endif
+  write4bits(value >> 4);
+  write4bits(value);
+}
+
+// Switches to left to right without shift for cells the driver lays out
+// itself, whatever the sketch's entry mode. Returns the mode for endRun().
+uint8_t LiquidCrystal_Base::beginRun() {
+  uint8_t mode = _displaymode;
+  if (mode != LCD_ENTRYLEFT) {
+    _displaymode = LCD_ENTRYLEFT; // so the address steps the same way
+    command(LCD_ENTRYMODESET | LCD_ENTRYLEFT);
+  }
+  return mode;
+}
+
+void LiquidCrystal_Base::endRun(uint8_t mode) {
+  if (mode != _displaymode) {
+    _displaymode = mode;
+    command(LCD_ENTRYMODESET | mode);
+  }
+}
+
+// The runs of a flush are planned one cell at a time, in the order the
+// controller's address counter steps. Addresses are DDRAM addresses, or
+// 0x80 plus a CGRAM address, like _address.
+void LiquidCrystal_Base::startRun(Run &run) {
+  run.next = 0xFF; // no address the counter can be at
+  run.mode = _displaymode;
+  run.sent = false;
+  run.gaps = 0;
+}
+
+// Sends `value` to `address` if it has `changed`. A run goes on over up to
+// LCD_ADDRESS_COST unchanged cells, sending them again, rather than set the
+// address; anything else starts a new run. The first run switches to left
+// to right; endRun(run.mode) switches back.
+void LiquidCrystal_Base::runCell(Run &run, uint8_t address, uint8_t value,
+                                 bool changed) {
+  if (!changed) {
+    if (address == run.next && run.gaps < LCD_ADDRESS_COST) {
+      run.gap[run.gaps++] = value;
+      run.next = (address & 0x80) ? (0x80 | ((address + 1) & 0x3F))
+                                  : nextAddress(address);
+    } else {
+      run.next = 0xFF;
+    }
+    return;
+  }
+
+  if (address == run.next) {
+    for (uint8_t i = 0; i < run.gaps; i++) {
+      putChar(run.gap[i]);
+    }
+  } else {
+    if (!run.sent) {
+      run.mode = beginRun();
+    }
+    _address = address;
+    restoreAddress();
+    setMode(HIGH);
+  }
+  putChar(value);
+  run.sent = true;
+  run.gaps = 0;
+  run.next = _address;
+}
+
+// Follows the controller's address counter after a data write: CGRAM wraps
+// every 64 bytes, a 1-line DDRAM every 80 and a 2-line DDRAM jumps between
+// the 0x00-0x27 and 0x40-0x67 halves.
+void LiquidCrystal_Base::stepAddress() {
+  if (_address & 0x80) {
+    int8_t step = (_displaymode & LCD_ENTRYLEFT) ? 1 : -1;
+    _address = 0x80 | ((_address + step) & 0x3F);
+  } else if (_displaymode & LCD_ENTRYLEFT) {
+    _address = nextAddress(_address);
   } else {
-    write4bits(value >> 4);
-    write4bits(value);
+    if (!(_displayfunction & LCD_2LINE)) {
+      _address = (_address == 0x00) ? 0x4F : _address - 1;
+    } else if (_address == 0x40) {
+      _address = 0x27;
+    } else {
+      _address = (_address == 0x00) ? 0x67 : _address - 1;
+    }
+  }
+}
+
+#if LCD_ENABLE_IDLE
+// Lets the sketch do other work, like sampling a sensor or kicking the
+// watchdog, while begin(), clear() and home() wait for the controller. The
+// hook is called repeatedly during every wait of at least `threshold` us
+// until that wait is over, so a wait can run late but never short. The bus is
+// idle at that point; the hook must not use this display itself. Pass NULL to
+// go back to plain delays.
+void LiquidCrystal_Base::setIdleHook(LiquidCrystal_IdleHook hook,
+                                     uint16_t threshold) {
+  _idle_hook = hook;
+  _idle_threshold = threshold;
+}
+#endif
+
+void LiquidCrystal_Base::wait(uint16_t us) {
+#if LCD_ENABLE_IDLE
+  if (_idle_hook && us >= _idle_threshold) {
+    unsigned long start = micros();
+    do {
+      _idle_hook();
+    } while (micros() - start < us);
+    return;
+  }
+#endif
+  delayMicroseconds(us);
+}
+
+#if LCD_ENABLE_TIMING
+// Uses a timing profile instead of the default worst-case waits, e.g.
+//
+//   static const LiquidCrystal_Timing st7066u = LCD_TIMING_ST7066U;
+//   lcd.setTiming(st7066u);
+void LiquidCrystal_Base::setTiming(const LiquidCrystal_Timing &timing) {
+  _timing = timing;
+}
+#else
+const LiquidCrystal_Timing LiquidCrystal_Base::_timing = LCD_TIMING;
+#endif
+
+#if LCD_ENABLE_RW
+#if LCD_ENABLE_TIMING
+// Measures how long this controller really stays busy, by polling the busy
+// flag after a short command, a data write and home(), and sets the timing
+// profile to that plus a 25% margin. Needs the RW pin; returns false, and
+// leaves the profile alone, without it or if the controller never reports
+// ready. Call it right after begin(): home() undoes any scrolling.
+bool LiquidCrystal_Base::calibrate() {
+  if (_rw_pin == 255) {
+    return false;
+  }
+  LiquidCrystal_Timing timing = _timing;
+  _timing.settle = 0; // poll the busy flag after every byte instead
+
+  command(LCD_ENTRYMODESET | _displaymode);
+  uint16_t settle = busyTime();
+
+  // a data write needs a cell nobody sees; begin() has already blanked it
+  uint8_t scratch = (_displayfunction & LCD_2LINE) ? 0x27 : 0x4F;
+  if (settle != 0xFFFF && cellAt(scratch) < 0) {
+    command(LCD_SETDDRAMADDR | scratch);
+    busyTime();
+    send(' ', HIGH);
+    uint16_t data = busyTime();
+    if (data > settle) {
+      settle = data;
+    }
+  }
+
+  uint16_t slow = 0xFFFF;
+  if (settle != 0xFFFF) {
+    command(LCD_RETURNHOME);
+    slow = busyTime();
+  }
+
+  _timing = timing;
+  restoreAddress();
+  if (settle == 0xFFFF || slow == 0xFFFF) {
+    return false;
+  }
+  settle += settle / 4 + 1;
+  _timing.settle = (settle < 0xFF) ? settle : 0xFF;
+  _timing.clear = slow + slow / 4 + 1;
+  return true;
+}
+
+// how long, in us, the busy flag stays set from now; 0xFFFF if it doesn't
+// clear within 10 ms
+uint16_t LiquidCrystal_Base::busyTime() {
+  unsigned long start = micros();
+  while (read(LOW) & 0x80) {
+    if (micros() - start > 10000) {
+      return 0xFFFF;
+    }
+  }
+  return micros() - start;
+}
+#endif
+
+// read the busy flag and address counter (LOW) or the data at the address
+// counter (HIGH); only possible with an RW pin
+uint8_t LiquidCrystal_Base::read(uint8_t mode) {
+  uint8_t bits = eightBit() ? 8 : 4;
+  for (uint8_t i = 0; i < bits; i++) {
+    pinMode(_data_pins[i], INPUT);
+  }
+  digitalWrite(_rs_pin, mode);
+  digitalWrite(_rw_pin, HIGH);
+
+  uint8_t value;
+  if (bits == 8) {
+    value = readBits(8);
+  } else {
+    value = readBits(4) << 4;
+    value |= readBits(4);
+  }
+
+  digitalWrite(_rw_pin, LOW);
+  for (uint8_t i = 0; i < bits; i++) {
+    pinMode(_data_pins[i], OUTPUT);
+  }
+  if (mode == HIGH) {
+    delayMicroseconds(_timing.settle); // reading RAM moves the address
+  }
+  return value;
+}
+
+uint8_t LiquidCrystal_Base::readBits(uint8_t count) {
+  digitalWrite(_enable_pin, HIGH);
+  delayMicroseconds(_timing.pulse); // data is valid 360 ns after enable rises
+  uint8_t value = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (digitalRead(_data_pins[i]) == HIGH) {
+      value |= 1 << i;
+    }
+  }
+  digitalWrite(_enable_pin, LOW);
+  delayMicroseconds(_timing.pulse);
+  return value;
+}
+#endif
+
+// the DDRAM address that follows `address` when incrementing
+uint8_t LiquidCrystal_Base::nextAddress(uint8_t address) {
+  if (!(_displayfunction & LCD_2LINE)) {
+    return (address >= 0x4F) ? 0x00 : address + 1;
+  } else if (address == 0x27) {
+    return 0x40;
   }
+  return (address >= 0x67) ? 0x00 : address + 1;
 }
 
 void LiquidCrystal_Base::pulseEnable(void) {
   digitalWrite(_enable_pin, LOW);
-  delayMicroseconds(1);
+  delayMicroseconds(_timing.pulse);
   digitalWrite(_enable_pin, HIGH);
-  delayMicroseconds(1); // enable pulse must be >450 ns
+  delayMicroseconds(_timing.pulse); // enable pulse must be >450 ns
   digitalWrite(_enable_pin, LOW);
-  delayMicroseconds(100); // commands need >37 us to settle
+  delayMicroseconds(_timing.settle); // commands need >37 us to settle
 }
 
 void LiquidCrystal_Base::write4bits(uint8_t value) {
@@ -309,6 +1253,7 @@ void LiquidCrystal_Base::write4bits(uint8_t value) {
   pulseEnable();
 }
 
+#if LCD_ENABLE_8BIT
 void LiquidCrystal_Base::write8bits(uint8_t value) {
   for (int i = 0; i < 8; i++) {
     digitalWrite(_data_pins[i], (value >> i) & 0x01);
@@ -316,3 +1261,4 @@ void LiquidCrystal_Base::write8bits(uint8_t value) {
 
   pulseEnable();
 }
+#endif
@@ -51,16 +51,227 @@
 #define LCD_5x10DOTS 0x04
 #define LCD_5x8DOTS 0x00
 
+// Capabilities a sketch can leave out to save flash and SRAM on small chips.
+// Arduino builds a library separately from the sketch, so these are set with
+// build flags, e.g. --build-property compiler.cpp.extra_flags=-DLCD_ENABLE_RW=0
+//
+//   LCD_ENABLE_8BIT=0   4-bit wiring only; the 8-bit constructors go away
+//   LCD_ENABLE_RW=0     no RW pin: no readback, verify() or calibrate()
+//   LCD_ENABLE_CGRAM=0  no custom characters, glyphs or big numbers
+//   LCD_ENABLE_UTF8=0   write() sends bytes as they are; begin() ignores
+//                       its character ROM and there are no glyphs
+//   LCD_ENABLE_FRAMES=0 refresh() sends the whole back buffer at once: no
+//                       setFrameRate() or urgent regions
+//   LCD_ENABLE_TIMING=0 the LCD_TIMING profile is fixed: no setTiming() or
+//                       calibrate()
+//   LCD_ENABLE_IDLE=0   waits are plain delays: no setIdleHook()
+//   LCD_FIXED_COLS=n    the geometry is fixed and begin() ignores its own;
+//   LCD_FIXED_ROWS=n    lets the compiler fold the row arithmetic
+#ifndef LCD_ENABLE_8BIT
+#define LCD_ENABLE_8BIT 1
+#endif
+#ifndef LCD_ENABLE_RW
+#define LCD_ENABLE_RW 1
+#endif
+#ifndef LCD_ENABLE_CGRAM
+#define LCD_ENABLE_CGRAM 1
+#endif
+#ifndef LCD_ENABLE_UTF8
+#define LCD_ENABLE_UTF8 1
+#endif
+#ifndef LCD_ENABLE_FRAMES
+#define LCD_ENABLE_FRAMES 1
+#endif
+#ifndef LCD_ENABLE_TIMING
+#define LCD_ENABLE_TIMING 1
+#endif
+#ifndef LCD_ENABLE_IDLE
+#define LCD_ENABLE_IDLE 1
+#endif
+
+// how many unchanged cells a flush rewrites rather than set the address
+// again; an address command takes as long on the bus as a data byte, and
+// switching RS for it adds a little more
+#ifndef LCD_ADDRESS_COST
+#define LCD_ADDRESS_COST 1
+#endif
+
+// how many regions setUrgent() can mark on one display
+#ifndef LCD_URGENT_REGIONS
+#define LCD_URGENT_REGIONS 4
+#endif
+
+// returned by reserveChar() when all CGRAM locations are taken
+#define LCD_NOCHAR 0xFF
+
+// character ROM for begin(); anything but LCD_ROM_RAW makes write() decode
+// UTF-8 and translate it to that ROM's character codes
+#define LCD_ROM_RAW 0x00
+#define LCD_ROM_A00 0x01 // Japanese standard font
+#define LCD_ROM_A02 0x02 // European standard font
+
+// a place on a flash-resident screen where the sketch prints a value
+struct LiquidCrystal_Field {
+  uint8_t col;
+  uint8_t row;
+  uint8_t width;
+};
+
+// A screen layout worked out by the compiler: static text and fields, each
+// with the DDRAM address it starts at, in a flash table that drawLayout()
+// walks without any arithmetic.
+//
+//   constexpr LiquidCrystal_Geometry panel = {16, 2};
+//   constexpr char tempLabel[] PROGMEM = "Temp";
+//   constexpr char unitLabel[] PROGMEM = "C";
+//   LCD_LAYOUT(status, panel,
+//              lcdText(panel, 0, 0, tempLabel),
+//              lcdField(panel, 5, 0, 5),
+//              lcdText(panel, 11, 0, unitLabel));
+//
+//   lcd.drawLayout(status);
+//   lcd.setCursor(&status[1]);
+//   lcd.print(21.5);
+//
+// The build fails if an item runs off the display or overlaps another. The
+// text must be PROGMEM arrays, not string literals. Rows are at the usual
+// DDRAM addresses: 0x00, 0x40, then cols and 0x40 + cols.
+struct LiquidCrystal_Geometry {
+  uint8_t cols;
+  uint8_t rows;
+};
+
+struct LiquidCrystal_Item {
+  uint8_t col;
+  uint8_t row;
+  uint8_t width;
+  uint8_t address;  // DDRAM address of the first cell
+  const char *text; // PROGMEM, or NULL for a field
+};
+
+constexpr uint8_t lcdAddress(LiquidCrystal_Geometry geometry, uint8_t col,
+                             uint8_t row) {
+  return col + ((row & 1) ? 0x40 : 0) + ((row & 2) ? geometry.cols : 0);
+}
+
+constexpr uint8_t lcdLength(const char *text, uint8_t length = 0) {
+  return text[length] ? lcdLength(text, length + 1) : length;
+}
+
+constexpr LiquidCrystal_Item lcdText(LiquidCrystal_Geometry geometry,
+                                     uint8_t col, uint8_t row,
+                                     const char *text) {
+  return LiquidCrystal_Item{col, row, lcdLength(text),
+                            lcdAddress(geometry, col, row), text};
+}
+
+constexpr LiquidCrystal_Item lcdField(LiquidCrystal_Geometry geometry,
+                                      uint8_t col, uint8_t row,
+                                      uint8_t width) {
+  return LiquidCrystal_Item{col, row, width, lcdAddress(geometry, col, row),
+                            NULL};
+}
+
+constexpr bool lcdOverlap(const LiquidCrystal_Item &a,
+                          const LiquidCrystal_Item &b) {
+  return a.row == b.row && a.col < b.col + b.width &&
+         b.col < a.col + a.width;
+}
+
+// whether items[i] overlaps any of the items from j on
+template <size_t N>
+constexpr bool lcdOverlapAny(const LiquidCrystal_Item (&items)[N], size_t i,
+                             size_t j) {
+  return j < N &&
+         (lcdOverlap(items[i], items[j]) || lcdOverlapAny(items, i, j + 1));
+}
+
+template <size_t N>
+constexpr bool lcdLayoutFits(const LiquidCrystal_Item (&items)[N],
+                             LiquidCrystal_Geometry geometry, size_t i = 0) {
+  return i >= N ||
+         (items[i].row < geometry.rows &&
+          items[i].col + items[i].width <= geometry.cols &&
+          !lcdOverlapAny(items, i, i + 1) &&
+          lcdLayoutFits(items, geometry, i + 1));
+}
+
+#define LCD_LAYOUT(name, geometry, ...)                                        \
+  constexpr LiquidCrystal_Item name[] PROGMEM = {__VA_ARGS__};                 \
+  static_assert(lcdLayoutFits(name, geometry),                                 \
+                #name ": an item runs off the display or overlaps another")
+
+// a custom character that translation loads into CGRAM on demand for a
+// code point the ROM doesn't have; tables of these live in PROGMEM
+struct LiquidCrystal_Glyph {
+  uint16_t codepoint;
+  uint8_t charmap[8];
+};
+
+// where a UTF-8 decoder is in a multi-byte sequence; a page keeps its own, so
+// that text for it and for the display can be written in turns
+struct LiquidCrystal_Utf8 {
+  uint8_t pending; // continuation bytes still to come
+  uint16_t codepoint;
+};
+
+// how long the driver waits on the bus, in us: the enable pulse width, the
+// settle time after a command or data byte and the time clear() and home()
+// take
+struct LiquidCrystal_Timing {
+  uint8_t pulse;
+  uint8_t settle;
+  uint16_t clear;
+};
+
+// timing profiles for setTiming(): the datasheet execution times (37 us and
+// 1.52 ms at 270 kHz) with a margin for oscillator spread, which is widest
+// on the HD44780U with its external resistor. The clear times, and the
+// ST7066U and SPLC780D settle times, assume an oscillator running at its
+// nominal frequency or faster: at the bottom of its range (190 kHz) a
+// controller needs up to 53 us and 2.16 ms, which calibrate() measures on
+// a display with an RW pin.
+#define LCD_TIMING_SLOW {1, 100, 2000}  // anything, even the slowest clones
+#define LCD_TIMING_HD44780 {1, 60, 2000} // 53 us at 190 kHz, plus 13%
+#define LCD_TIMING_ST7066U {1, 45, 2000}
+#define LCD_TIMING_SPLC780D {1, 45, 2000}
+
+// the profile every display starts with; a sketch that knows its controller
+// can pin another one at compile time, e.g. -DLCD_TIMING=LCD_TIMING_ST7066U
+#ifndef LCD_TIMING
+#define LCD_TIMING LCD_TIMING_SLOW
+#endif
+
+// called over and over while the driver waits out a slow command; see
+// setIdleHook()
+typedef void (*LiquidCrystal_IdleHook)();
+
+class LiquidCrystal_Page;
+class LiquidCrystal_Mirror;
+class LiquidCrystal_Console;
+class LiquidCrystal_Canvas;
+
 class LiquidCrystal_Base : public Print {
+  friend class LiquidCrystal_Page;
+  friend class LiquidCrystal_Mirror;
+  friend class LiquidCrystal_Console;
+  friend class LiquidCrystal_Canvas;
+
 public:
+#if LCD_ENABLE_8BIT
   LiquidCrystal_Base(uint8_t rs, uint8_t enable, uint8_t d0, uint8_t d1,
                      uint8_t d2, uint8_t d3, uint8_t d4, uint8_t d5, uint8_t d6,
                      uint8_t d7);
+#if LCD_ENABLE_RW
   LiquidCrystal_Base(uint8_t rs, uint8_t rw, uint8_t enable, uint8_t d0,
                      uint8_t d1, uint8_t d2, uint8_t d3, uint8_t d4, uint8_t d5,
                      uint8_t d6, uint8_t d7);
+#endif
+#endif
+#if LCD_ENABLE_RW
   LiquidCrystal_Base(uint8_t rs, uint8_t rw, uint8_t enable, uint8_t d0,
                      uint8_t d1, uint8_t d2, uint8_t d3);
+#endif
   LiquidCrystal_Base(uint8_t rs, uint8_t enable, uint8_t d0, uint8_t d1,
                      uint8_t d2, uint8_t d3);
 
@@ -68,7 +279,9 @@ public:
             uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3, uint8_t d4,
             uint8_t d5, uint8_t d6, uint8_t d7);
 
-  void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+  void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS,
+             uint8_t rom = LCD_ROM_RAW);
+  void resync();
 
   void clear();
   void home();
@@ -87,35 +300,229 @@ public:
   void noAutoscroll();
 
   void setRowOffsets(int row1, int row2, int row3, int row4);
+#if LCD_ENABLE_CGRAM
   void createChar(uint8_t, uint8_t[]);
+  uint8_t reserveChar();
+  void releaseChar(uint8_t);
+#if LCD_ENABLE_UTF8
+  void setGlyphs(const LiquidCrystal_Glyph *glyphs, uint8_t count,
+                 uint8_t slots);
+#endif
+#endif
   void setCursor(uint8_t, uint8_t);
+  void setCursor(const LiquidCrystal_Field *);
+  void setCursor(const LiquidCrystal_Item *);
   virtual size_t write(uint8_t);
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  size_t writeRaw(uint8_t);
+  size_t writeChanged(const uint8_t *buffer, size_t size);
+  size_t writeRTL(uint8_t col, uint8_t row, const uint8_t *buffer,
+                  size_t size);
+  size_t printRight(uint8_t col, uint8_t row, long value, uint8_t width = 0,
+                    uint8_t decimals = 0);
+  size_t print(const __FlashStringHelper *);
+  void drawScreen(const __FlashStringHelper *);
+  void drawLayout(const LiquidCrystal_Item *items, uint8_t count);
+  template <size_t N> void drawLayout(const LiquidCrystal_Item (&items)[N]) {
+    drawLayout(items, N);
+  }
+  void attachShadow(uint8_t *);
+  void skipUnchanged(bool skip = true);
+#if LCD_ENABLE_CGRAM
+  void attachCharCache(uint8_t *);
+#endif
+  void attachBackBuffer(uint8_t *);
+#if LCD_ENABLE_FRAMES
+  void setFrameRate(uint8_t fps, uint16_t budget = 0);
+  bool setUrgent(uint8_t col, uint8_t row, uint8_t width);
+  bool setUrgent(const LiquidCrystal_Item *);
+  void clearUrgent();
+#endif
+  bool refresh();
+  void drawFrame(const uint8_t *);
   void command(uint8_t);
+#if LCD_ENABLE_TIMING
+  void setTiming(const LiquidCrystal_Timing &);
+#endif
+  const LiquidCrystal_Timing &timing() const { return _timing; }
+#if LCD_ENABLE_RW
+#if LCD_ENABLE_TIMING
+  bool calibrate();
+#endif
+  uint8_t readAddressCounter();
+  size_t readDDRAM(uint8_t address, uint8_t *buffer, size_t size);
+#if LCD_ENABLE_CGRAM
+  size_t readCGRAM(uint8_t address, uint8_t *buffer, size_t size);
+#endif
+  uint16_t verify(bool repair = true);
+#endif
+#if LCD_ENABLE_IDLE
+  void setIdleHook(LiquidCrystal_IdleHook hook, uint16_t threshold = 1000);
+#endif
 #ifdef MOCK_PINS_COUNT
   virtual String className() const { return "LiquidCrystal_Base"; }
 #endif
 
+  using Print::print;
   using Print::write;
 
+protected:
+#if LCD_ENABLE_UTF8
+  bool translate(uint8_t &value) { return translate(value, _utf8); }
+  bool translate(uint8_t &, LiquidCrystal_Utf8 &);
+  bool translating() const { return _rom != LCD_ROM_RAW; }
+#else
+  bool translate(uint8_t &) { return true; }
+  bool translating() const { return false; }
+#endif
+  void sendChar(uint8_t);
+  uint8_t entryMode() const { return _displaymode; }
+  uint8_t rowOffset(uint8_t row) const { return _row_offsets[row]; }
+#ifdef MOCK_PINS_COUNT
+  // sees every command (LOW) and data byte (HIGH) as it goes on the bus, so
+  // a test double can follow the display rather than the API
+  virtual void sent(uint8_t, uint8_t) {}
+#endif
+
 private:
   void send(uint8_t, uint8_t);
+  void setMode(uint8_t);
+  void sendBits(uint8_t);
+  void pushChar(uint8_t);
+  void putChar(uint8_t);
+  uint8_t beginRun();
+  void endRun(uint8_t);
+  struct Run {
+    uint8_t next; // where the controller's address is, or 0xFF
+    uint8_t mode; // the entry mode to go back to
+    bool sent;
+    uint8_t gaps;                      // unchanged cells since the last sent
+    uint8_t gap[LCD_ADDRESS_COST + 1]; // and what they show
+  };
+  void startRun(Run &);
+  void runCell(Run &, uint8_t, uint8_t, bool);
+  void stepAddress();
+  uint8_t nextAddress(uint8_t);
+  uint16_t flush(const uint8_t *, uint16_t, uint16_t, bool &);
+#if LCD_ENABLE_FRAMES
+  bool flushUrgent();
+#endif
+  int16_t cellAt(uint8_t);
+#if LCD_ENABLE_UTF8 && LCD_ENABLE_CGRAM
+  uint8_t lookupGlyph(uint16_t);
+#endif
+  void restoreAddress();
+  void setAddress(uint8_t, uint8_t);
+  void setEntryMode(uint8_t);
+#if LCD_ENABLE_RW
+  uint8_t read(uint8_t);
+  uint8_t readBits(uint8_t);
+  size_t readRam(uint8_t, uint8_t *, size_t);
+#if LCD_ENABLE_TIMING
+  uint16_t busyTime();
+#endif
+#endif
   void write4bits(uint8_t);
+#if LCD_ENABLE_8BIT
   void write8bits(uint8_t);
+#endif
   void pulseEnable();
+  void wait(uint16_t);
 
-  uint8_t _rs_pin;     // LOW: command. HIGH: character.
-  uint8_t _rw_pin;     // LOW: write to LCD. HIGH: read from LCD.
+  bool eightBit() const {
+#if LCD_ENABLE_8BIT
+    return _displayfunction & LCD_8BITMODE;
+#else
+    return false;
+#endif
+  }
+
+  // the capabilities compiled out become constants, so that the code that
+  // tests for them folds away. The bytes come first and the wider members
+  // after them, so that no padding goes in between.
+  uint8_t _rs_pin; // LOW: command. HIGH: character.
+#if LCD_ENABLE_RW
+  uint8_t _rw_pin; // LOW: write to LCD. HIGH: read from LCD.
+#else
+  static const uint8_t _rw_pin = 255;
+#endif
   uint8_t _enable_pin; // activated by a HIGH pulse.
-  uint8_t _data_pins[8];
+  uint8_t _data_pins[LCD_ENABLE_8BIT ? 8 : 4];
 
   uint8_t _displayfunction;
   uint8_t _displaycontrol;
   uint8_t _displaymode;
 
-  uint8_t _initialized;
-
+#ifdef LCD_FIXED_ROWS
+  static const uint8_t _numlines = LCD_FIXED_ROWS;
+#else
   uint8_t _numlines;
+#endif
+#ifdef LCD_FIXED_COLS
+  static const uint8_t _cols = LCD_FIXED_COLS;
+#else
+  uint8_t _cols;
+#endif
   uint8_t _row_offsets[4];
+
+  // our copy of the controller's address counter; bit 7 set means it points
+  // into CGRAM rather than DDRAM
+  uint8_t _address;
+
+  bool _skip_unchanged : 1;
+  bool _skipped : 1; // the controller's address counter lags behind _address
+
+#if LCD_ENABLE_CGRAM
+  uint8_t _cgram_used;  // bit n set: CGRAM location n is in use
+  uint8_t _cgram_dirty; // bit n set: CGRAM location n changed
+#endif
+
+#if LCD_ENABLE_FRAMES
+  // the regions refresh() sends first
+  uint8_t _urgent_col[LCD_URGENT_REGIONS];
+  uint8_t _urgent_row[LCD_URGENT_REGIONS];
+  uint8_t _urgent_width[LCD_URGENT_REGIONS];
+  uint8_t _urgent_count;
+#endif
+
+#if LCD_ENABLE_UTF8
+  uint8_t _rom;
+  LiquidCrystal_Utf8 _utf8;
+#endif
+
+#if LCD_ENABLE_UTF8 && LCD_ENABLE_CGRAM
+  uint8_t _glyph_count;
+  uint8_t _glyph_slots; // most CGRAM locations translation may take
+  uint8_t _glyph_owned; // bit n set: location n holds a translated glyph
+  uint8_t _glyph_next;  // location to evict next when all are taken
+  uint16_t _glyph_codepoint[8];
+  const LiquidCrystal_Glyph *_glyphs;
+#endif
+
+#if LCD_ENABLE_TIMING
+  LiquidCrystal_Timing _timing;
+#else
+  static const LiquidCrystal_Timing _timing;
+#endif
+
+#if LCD_ENABLE_IDLE
+  uint16_t _idle_threshold; // shortest wait, in us, that runs the hook
+  LiquidCrystal_IdleHook _idle_hook;
+#endif
+
+#if LCD_ENABLE_FRAMES
+  uint16_t _frame_budget; // most time one refresh() may take, or 0
+  uint16_t _frame_cell;   // where the unfinished frame goes on, or 0xFFFF
+  unsigned long _frame_interval; // shortest time between frames, in us
+  unsigned long _frame_start;
+#endif
+
+  uint8_t *_shadow; // what is on the display, cols x rows, or NULL
+  uint8_t *_back;   // what refresh() brings the display to, or NULL
+  uint8_t *_dirty;  // bit n set: shadow cell n changed, or NULL
+#if LCD_ENABLE_CGRAM
+  uint8_t *_cgram_cache; // what is in CGRAM, 64 bytes, or NULL
+#endif
 };
 
 #endif
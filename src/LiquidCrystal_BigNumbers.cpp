@@ -0,0 +1,215 @@
+#include "LiquidCrystal_BigNumbers.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#if LCD_ENABLE_CGRAM
+
+// cell codes used in the font tables below
+#define BIG_BLANK 0
+#define BIG_FULL 1
+#define BIG_TOP 2
+#define BIG_BOTTOM 3
+#define BIG_BOTH 4
+
+// symbol indexes: '0'-'9' are 0-9
+#define BIG_MINUS 10
+#define BIG_SPACE 11
+#define BIG_UNKNOWN 0xFF
+
+#define _ BIG_BLANK
+#define X BIG_FULL
+#define T BIG_TOP
+#define B BIG_BOTTOM
+#define H BIG_BOTH
+
+// 3 columns by 2 rows; the middle bar is the bottom half of the top row
+static const uint8_t font2[12][2][3] PROGMEM = {
+    {{X, T, X}, {X, B, X}}, // 0
+    {{T, X, _}, {B, X, B}}, // 1
+    {{H, H, X}, {X, B, B}}, // 2
+    {{H, H, X}, {B, B, X}}, // 3
+    {{X, B, X}, {_, _, X}}, // 4
+    {{X, H, H}, {B, B, X}}, // 5
+    {{X, H, H}, {X, B, X}}, // 6
+    {{T, T, X}, {_, _, X}}, // 7
+    {{X, H, X}, {X, B, X}}, // 8
+    {{X, H, X}, {B, B, X}}, // 9
+    {{B, B, B}, {_, _, _}}, // -
+    {{_, _, _}, {_, _, _}}, // space
+};
+
+// 3 columns by 4 rows; only needs the top and bottom bar glyphs
+static const uint8_t font4[12][4][3] PROGMEM = {
+    {{X, T, X}, {X, _, X}, {X, _, X}, {X, B, X}}, // 0
+    {{T, X, _}, {_, X, _}, {_, X, _}, {B, X, B}}, // 1
+    {{T, T, X}, {B, B, X}, {X, _, _}, {X, B, B}}, // 2
+    {{T, T, X}, {B, B, X}, {_, _, X}, {B, B, X}}, // 3
+    {{X, _, X}, {X, B, X}, {_, _, X}, {_, _, X}}, // 4
+    {{X, T, T}, {X, B, B}, {_, _, X}, {B, B, X}}, // 5
+    {{X, T, T}, {X, B, B}, {X, _, X}, {X, B, X}}, // 6
+    {{T, T, X}, {_, _, X}, {_, _, X}, {_, _, X}}, // 7
+    {{X, T, X}, {X, B, X}, {X, _, X}, {X, B, X}}, // 8
+    {{X, T, X}, {X, B, X}, {_, _, X}, {B, B, X}}, // 9
+    {{_, _, _}, {B, B, B}, {_, _, _}, {_, _, _}}, // -
+    {{_, _, _}, {_, _, _}, {_, _, _}, {_, _, _}}, // space
+};
+
+#undef _
+#undef X
+#undef T
+#undef B
+#undef H
+
+// top bar, bottom bar, both bars
+static const uint8_t segments[3][8] PROGMEM = {
+    {0b11111, 0b11111, 0b11111, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0b11111, 0b11111, 0b11111},
+    {0b11111, 0b11111, 0b11111, 0, 0, 0b11111, 0b11111, 0b11111},
+};
+
+LiquidCrystal_BigNumbers::LiquidCrystal_BigNumbers(LiquidCrystal_Base &lcd,
+                                                   uint8_t cols, uint8_t rows,
+                                                   uint8_t height, uint8_t top)
+    : _lcd(lcd) {
+  if (height == 0) {
+    height = (rows >= 4) ? 4 : 2;
+  }
+  _height = (height >= 4) ? 4 : 2;
+  _top = top;
+
+  // each digit is 3 columns wide, with one blank column between digits
+  _positions = (cols + 1) / 4;
+  if (_positions > LCD_BIGNUM_MAXPOSITIONS) {
+    _positions = LCD_BIGNUM_MAXPOSITIONS;
+  }
+  _cursor = 0;
+
+  for (uint8_t i = 0; i < 3; i++) {
+    _glyphs[i] = LCD_NOCHAR;
+  }
+  memset(_shown, BIG_UNKNOWN, sizeof(_shown));
+}
+
+// Reserves and defines the segment glyphs. Returns false if the display has
+// too few free CGRAM locations left.
+bool LiquidCrystal_BigNumbers::begin() {
+  end();
+
+  uint8_t count = (_height == 4) ? 2 : 3;
+  for (uint8_t i = 0; i < count; i++) {
+    _glyphs[i] = _lcd.reserveChar();
+    if (_glyphs[i] == LCD_NOCHAR) {
+      end();
+      return false;
+    }
+  }
+
+  uint8_t charmap[8];
+  for (uint8_t i = 0; i < count; i++) {
+    memcpy_P(charmap, segments[i], sizeof(charmap));
+    _lcd.createChar(_glyphs[i], charmap);
+  }
+
+  // we don't know what is on the display, so the first draw sends every cell
+  memset(_shown, BIG_UNKNOWN, sizeof(_shown));
+  _cursor = 0;
+  return true;
+}
+
+// Gives the CGRAM locations back to the display.
+void LiquidCrystal_BigNumbers::end() {
+  for (uint8_t i = 0; i < 3; i++) {
+    if (_glyphs[i] != LCD_NOCHAR) {
+      _lcd.releaseChar(_glyphs[i]);
+      _glyphs[i] = LCD_NOCHAR;
+    }
+  }
+}
+
+void LiquidCrystal_BigNumbers::clear() {
+  for (uint8_t position = 0; position < _positions; position++) {
+    draw(position, BIG_SPACE);
+  }
+  _cursor = 0;
+}
+
+void LiquidCrystal_BigNumbers::setCursor(uint8_t position) {
+  _cursor = position;
+}
+
+size_t LiquidCrystal_BigNumbers::write(uint8_t value) {
+  if (value == '\r') {
+    _cursor = 0;
+    return 1;
+  }
+  if (value == '\n') {
+    return 1;
+  }
+  if (_cursor >= _positions) {
+    return 0;
+  }
+
+  uint8_t symbol = BIG_SPACE;
+  if (value >= '0' && value <= '9') {
+    symbol = value - '0';
+  } else if (value == '-') {
+    symbol = BIG_MINUS;
+  }
+  draw(_cursor++, symbol);
+  return 1;
+}
+
+// the character code to send for one cell of a symbol
+uint8_t LiquidCrystal_BigNumbers::cell(uint8_t symbol, uint8_t row,
+                                       uint8_t col) {
+  uint8_t code;
+  if (_height == 4) {
+    code = pgm_read_byte(&font4[symbol][row][col]);
+  } else {
+    code = pgm_read_byte(&font2[symbol][row][col]);
+  }
+
+  switch (code) {
+  case BIG_FULL:
+    return 0xFF; // full block in both the A00 and A02 ROMs
+  case BIG_TOP:
+    return _glyphs[0];
+  case BIG_BOTTOM:
+    return _glyphs[1];
+  case BIG_BOTH:
+    return _glyphs[2];
+  default:
+    return ' ';
+  }
+}
+
+// Rewrites only the cells that differ between what the position showed and
+// the new symbol, one setCursor() per run of changed cells on each row.
+void LiquidCrystal_BigNumbers::draw(uint8_t position, uint8_t symbol) {
+  uint8_t old = _shown[position];
+  if (old == symbol) {
+    return;
+  }
+
+  uint8_t left = position * 4;
+  for (uint8_t row = 0; row < _height; row++) {
+    uint8_t col = 0;
+    while (col < 3) {
+      if (old != BIG_UNKNOWN &&
+          cell(old, row, col) == cell(symbol, row, col)) {
+        col++;
+        continue;
+      }
+      _lcd.setCursor(left + col, _top + row);
+      do {
+        _lcd.writeRaw(cell(symbol, row, col));
+        col++;
+      } while (col < 3 && (old == BIG_UNKNOWN ||
+                           cell(old, row, col) != cell(symbol, row, col)));
+    }
+  }
+  _shown[position] = symbol;
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef LiquidCrystal_BigNumbers_h
+#define LiquidCrystal_BigNumbers_h
+
+#include "LiquidCrystal.h"
+
+#if LCD_ENABLE_CGRAM
+
+// a 40 column display holds ten 3-wide digits with a blank column between
+#define LCD_BIGNUM_MAXPOSITIONS 10
+
+// Draws 2-row or 4-row tall digits composed from a handful of shared segment
+// glyphs (a top bar, a bottom bar and, for 2-row digits, both bars together)
+// plus the ROM full block. The glyphs are defined once into CGRAM locations
+// obtained from reserveChar(), so the rest of CGRAM stays free for the sketch.
+//
+// It is a Print, so numbers are formatted the usual way:
+//
+//   LiquidCrystal_BigNumbers big(lcd, 20, 4);
+//   big.begin();
+//   big.setCursor(1);
+//   big.print(42);
+//
+// Every position remembers what it shows, so printing a value only rewrites
+// the cells of the digits that actually changed.
+class LiquidCrystal_BigNumbers : public Print {
+public:
+  // height is 2 or 4 rows; 0 picks 4 on 4-row displays and 2 otherwise.
+  // top is the display row the digits start on.
+  LiquidCrystal_BigNumbers(LiquidCrystal_Base &lcd, uint8_t cols, uint8_t rows,
+                           uint8_t height = 0, uint8_t top = 0);
+
+  bool begin();
+  void end();
+
+  void clear();
+  void setCursor(uint8_t position);
+  uint8_t positions() const { return _positions; }
+  virtual size_t write(uint8_t);
+
+  using Print::write;
+
+private:
+  uint8_t cell(uint8_t symbol, uint8_t row, uint8_t col);
+  void draw(uint8_t position, uint8_t symbol);
+
+  LiquidCrystal_Base &_lcd;
+  uint8_t _height;
+  uint8_t _top;
+  uint8_t _positions;
+  uint8_t _cursor;
+  uint8_t _glyphs[3]; // CGRAM locations of the top, bottom and both bars
+  uint8_t _shown[LCD_BIGNUM_MAXPOSITIONS];
+};
+
+#endif
+#endif
@@ -41,10 +41,12 @@ void LiquidCrystal_CI::init(uint8_t rs) {
   _row = 0;
   _rows = 1;
   _autoscroll = false;
+  _increment = true;
   _display = false;
   _cursor = false;
   _blink = false;
-  _isInCreateChar = false;
+  _inCgram = false;
+  _cgram = 0;
   _lines.clear();
   _lines.resize(_rows);
   for (int character = 0; character < 8; character++) {
@@ -55,112 +57,76 @@ void LiquidCrystal_CI::init(uint8_t rs) {
   LiquidCrystal_CI::_instances[_rs_pin] = this;
 }
 
-void LiquidCrystal_CI::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) {
-  LiquidCrystal_Base::begin(cols, lines, dotsize);
-  _col = 0;
+void LiquidCrystal_CI::begin(uint8_t cols, uint8_t lines, uint8_t dotsize,
+                             uint8_t rom) {
+  // the size first: begin() clears the display through sent()
   _cols = cols;
-  _row = 0;
   _rows = lines;
-  _autoscroll = false;
-  _display = false;
-  _cursor = false;
-  _blink = false;
-  _isInCreateChar = false;
   _lines.clear();
   _lines.resize(_rows);
+  LiquidCrystal_Base::begin(cols, lines, dotsize, rom);
+}
+
+// Follows the display the way the controller would, from the bytes the
+// driver puts on the bus, so everything the library draws is tracked
+// whichever of its functions drew it.
+void LiquidCrystal_CI::sent(uint8_t value, uint8_t mode) {
+  if (mode == HIGH) {
+    place(value);
+  } else if (value & LCD_SETDDRAMADDR) {
+    _inCgram = false;
+    locate(value & 0x7F);
+  } else if (value & LCD_SETCGRAMADDR) {
+    _inCgram = true;
+    _cgram = value & 0x3F;
+  } else if (value & LCD_FUNCTIONSET) {
+    // the geometry comes from begin()
+  } else if (value & LCD_CURSORSHIFT) {
+    // scrolling moves the picture, not the text in RAM
+  } else if (value & LCD_DISPLAYCONTROL) {
+    _display = value & LCD_DISPLAYON;
+    _cursor = value & LCD_CURSORON;
+    _blink = value & LCD_BLINKON;
+  } else if (value & LCD_ENTRYMODESET) {
+    _increment = value & LCD_ENTRYLEFT;
+    _autoscroll = value & LCD_ENTRYSHIFTINCREMENT;
+  } else if (value & LCD_RETURNHOME) {
+    _inCgram = false;
+    _col = _row = 0;
+  } else if (value == LCD_CLEARDISPLAY) {
+    _inCgram = false;
+    _col = _row = 0;
+    _increment = true;
+    _lines.clear();
+    _lines.resize(_rows);
+  }
 }
 
-/********** high level commands, for the user! */
-void LiquidCrystal_CI::clear() {
-  LiquidCrystal_Base::clear();
-  _lines.clear();
-  _lines.resize(_rows);
-}
-
-void LiquidCrystal_CI::home() {
-  LiquidCrystal_Base::home();
-  _col = _row = 0;
-}
-
-void LiquidCrystal_CI::setCursor(uint8_t col, uint8_t row) {
-  LiquidCrystal_Base::setCursor(col, row);
-  _col = col;
+// puts the cursor on the row whose addresses hold `address`
+void LiquidCrystal_CI::locate(uint8_t address) {
+  int row = 0;
+  for (int r = 1; r < _rows && r < 4; r++) {
+    uint8_t offset = rowOffset(r);
+    if (offset <= address && (offset & 0x40) == (address & 0x40) &&
+        ((rowOffset(row) & 0x40) != (address & 0x40) ||
+         offset > rowOffset(row))) {
+      row = r;
+    }
+  }
   _row = row;
+  _col = address - rowOffset(row);
 }
 
-// Turn the display on/off (quickly)
-void LiquidCrystal_CI::noDisplay() {
-  LiquidCrystal_Base::noDisplay();
-  _display = false;
-}
-void LiquidCrystal_CI::display() {
-  LiquidCrystal_Base::display();
-  _display = true;
-}
-
-// Turns the underline cursor on/off
-void LiquidCrystal_CI::noCursor() {
-  LiquidCrystal_Base::noCursor();
-  _cursor = false;
-}
-void LiquidCrystal_CI::cursor() {
-  LiquidCrystal_Base::cursor();
-  _cursor = true;
-}
-
-// Turn on and off the blinking cursor
-void LiquidCrystal_CI::noBlink() {
-  LiquidCrystal_Base::noBlink();
-  _blink = false;
-}
-void LiquidCrystal_CI::blink() {
-  LiquidCrystal_Base::blink();
-  _blink = true;
-}
-
-// These commands scroll the display without changing the RAM
-void LiquidCrystal_CI::scrollDisplayLeft() {
-  LiquidCrystal_Base::scrollDisplayLeft();
-}
-void LiquidCrystal_CI::scrollDisplayRight() {
-  LiquidCrystal_Base::scrollDisplayRight();
-}
-
-// This is for text that flows Left to Right
-void LiquidCrystal_CI::leftToRight() { LiquidCrystal_Base::leftToRight(); }
-
-// This is for text that flows Right to Left
-void LiquidCrystal_CI::rightToLeft() { LiquidCrystal_Base::rightToLeft(); }
-
-// This will 'right justify' text from the cursor
-void LiquidCrystal_CI::autoscroll() {
-  LiquidCrystal_Base::autoscroll();
-  _autoscroll = true;
-}
-
-// This will 'left justify' text from the cursor
-void LiquidCrystal_CI::noAutoscroll() {
-  LiquidCrystal_Base::noAutoscroll();
-  _autoscroll = false;
-}
-
-// Allows us to fill the first 8 CGRAM locations
-// with custom characters
-void LiquidCrystal_CI::createChar(uint8_t location, uint8_t charmap[]) {
-  _isInCreateChar = true;
-  LiquidCrystal_Base::createChar(location, charmap);
-  _isInCreateChar = false;
-  // fill the customChars with the charmap
-  for (int line = 0; line < 8; line++) {
-    _customChars[location][line] = charmap[line];
+void LiquidCrystal_CI::place(uint8_t value) {
+  if (_inCgram) {
+    _customChars[_cgram >> 3][_cgram & 7] = value;
+    _cgram = (_cgram + (_increment ? 1 : -1)) & 0x3F;
+    return;
   }
-}
-
-inline size_t LiquidCrystal_CI::write(uint8_t value) {
-  if (!_isInCreateChar) {
+  if (_increment) {
     String line = _lines.at(_row);
     int end = _autoscroll ? (_col - 1) : _col;
-    while (line.length() <= end) {
+    while ((int)line.length() <= end) {
       line += ' ';
     }
 
@@ -175,13 +141,27 @@ inline size_t LiquidCrystal_CI::write(uint8_t value) {
     ++_col;
 
     _lines.at(_row) = line;
-  }
-  return LiquidCrystal_Base::write(value);
-}
+  } else if (_col >= 0) {
+    // right to left: the cursor moves left, or with autoscroll the text
+    // after it moves right
+    String line = _lines.at(_row);
+    int end = _autoscroll ? (_col + 1) : _col;
+    while ((int)line.length() <= end) {
+      line += ' ';
+    }
 
-// override lower-level write to capture output
-size_t LiquidCrystal_CI::write(const char *buffer, size_t size) {
-  return LiquidCrystal_Base::write(buffer, size);
+    if (_autoscroll) {
+      for (int i = line.length() - 1; i > _col + 1; i--) {
+        line.at(i) = line.at(i - 1);
+      }
+      ++_col;
+    }
+
+    line.at(_col) = value;
+    --_col;
+
+    _lines.at(_row) = line;
+  }
 }
 
 // private data and functions to support testing
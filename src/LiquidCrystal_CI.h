@@ -18,25 +18,8 @@ public:
   LiquidCrystal_CI(uint8_t rs, uint8_t enable, uint8_t d0, uint8_t d1,
                    uint8_t d2, uint8_t d3);
   ~LiquidCrystal_CI() { LiquidCrystal_CI::_instances[_rs_pin] = nullptr; }
-  void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
-  void clear();
-  void home();
-  void noDisplay();
-  void display();
-  void noBlink();
-  void blink();
-  void noCursor();
-  void cursor();
-  void scrollDisplayLeft();
-  void scrollDisplayRight();
-  void leftToRight();
-  void rightToLeft();
-  void autoscroll();
-  void noAutoscroll();
-  void createChar(uint8_t, uint8_t[]);
-  void setCursor(uint8_t, uint8_t);
-  size_t write(uint8_t);
-  size_t write(const char *buffer, size_t size);
+  void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS,
+             uint8_t rom = LCD_ROM_RAW);
   virtual String className() const { return "LiquidCrystal_CI"; }
 
   // testing methods
@@ -55,13 +38,19 @@ public:
   int getCursorCol() { return _col; }
   int getCursorRow() { return _row; }
 
+protected:
+  void sent(uint8_t value, uint8_t mode);
+
 private:
   static LiquidCrystal_CI *_instances[MOCK_PINS_COUNT];
   int _col, _cols, _row, _rows, _rs_pin;
-  bool _display, _cursor, _blink, _autoscroll, _isInCreateChar;
+  bool _display, _cursor, _blink, _autoscroll, _increment, _inCgram;
+  uint8_t _cgram;
   std::vector<String> _lines;
   byte _customChars[8][8];
   void init(uint8_t rs);
+  void locate(uint8_t address);
+  void place(uint8_t value);
 };
 
 #endif
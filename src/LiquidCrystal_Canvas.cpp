@@ -0,0 +1,148 @@
+#include "LiquidCrystal_Canvas.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if LCD_ENABLE_CGRAM
+
+LiquidCrystal_Canvas::LiquidCrystal_Canvas(LiquidCrystal_Base &lcd,
+                                           uint8_t cols, uint8_t rows)
+    : _lcd(lcd), _cols(cols), _rows(rows) {
+  if (_rows == 0 || _rows > 8) {
+    _rows = 1;
+  }
+  if (_cols * _rows > 8) {
+    _cols = 8 / _rows;
+  }
+  memset(_glyphs, LCD_NOCHAR, sizeof(_glyphs));
+  memset(_bitmap, 0, sizeof(_bitmap));
+  memset(_dirty, 0, sizeof(_dirty));
+}
+
+// Reserves a CGRAM location for every cell and blanks them. Returns false if
+// the display has too few free locations left.
+bool LiquidCrystal_Canvas::begin() {
+  end();
+  for (uint8_t cell = 0; cell < _cols * _rows; cell++) {
+    _glyphs[cell] = _lcd.reserveChar();
+    if (_glyphs[cell] == LCD_NOCHAR) {
+      end();
+      return false;
+    }
+  }
+  // we don't know what is in CGRAM, so the first update sends everything
+  memset(_bitmap, 0, sizeof(_bitmap));
+  memset(_dirty, 0xFF, sizeof(_dirty));
+  update();
+  return true;
+}
+
+// Gives the CGRAM locations back to the display.
+void LiquidCrystal_Canvas::end() {
+  for (uint8_t cell = 0; cell < 8; cell++) {
+    if (_glyphs[cell] != LCD_NOCHAR) {
+      _lcd.releaseChar(_glyphs[cell]);
+      _glyphs[cell] = LCD_NOCHAR;
+    }
+  }
+}
+
+void LiquidCrystal_Canvas::clear() {
+  for (uint8_t i = 0; i < _cols * _rows * 8; i++) {
+    if (_bitmap[i]) {
+      _bitmap[i] = 0;
+      _dirty[i >> 3] |= 1 << (i & 7);
+    }
+  }
+}
+
+// Pixels off the canvas are ignored. x counts from the left, y from the top.
+void LiquidCrystal_Canvas::setPixel(uint8_t x, uint8_t y, bool on) {
+  if (x >= width() || y >= height()) {
+    return;
+  }
+  uint8_t cell = (y >> 3) * _cols + x / 5;
+  uint8_t i = cell * 8 + (y & 7);
+  uint8_t bit = 0x10 >> (x % 5);
+  uint8_t bits = on ? (_bitmap[i] | bit) : (_bitmap[i] & ~bit);
+  if (bits != _bitmap[i]) {
+    _bitmap[i] = bits;
+    _dirty[cell] |= 1 << (y & 7);
+  }
+}
+
+bool LiquidCrystal_Canvas::pixel(uint8_t x, uint8_t y) const {
+  if (x >= width() || y >= height()) {
+    return false;
+  }
+  uint8_t cell = (y >> 3) * _cols + x / 5;
+  return _bitmap[cell * 8 + (y & 7)] & (0x10 >> (x % 5));
+}
+
+void LiquidCrystal_Canvas::line(uint8_t x0, uint8_t y0, uint8_t x1,
+                                uint8_t y1, bool on) {
+  // Bresenham, in whichever direction the line runs
+  int16_t dx = abs(x1 - x0);
+  int16_t dy = -abs(y1 - y0);
+  int8_t sx = (x0 < x1) ? 1 : -1;
+  int8_t sy = (y0 < y1) ? 1 : -1;
+  int16_t error = dx + dy;
+  for (;;) {
+    setPixel(x0, y0, on);
+    if (x0 == x1 && y0 == y1) {
+      return;
+    }
+    int16_t twice = 2 * error;
+    if (twice >= dy) {
+      error += dy;
+      x0 += sx;
+    }
+    if (twice <= dx) {
+      error += dx;
+      y0 += sy;
+    }
+  }
+}
+
+// Sets the pixels of column x from row top to row bottom, both included.
+void LiquidCrystal_Canvas::fillColumn(uint8_t x, uint8_t top, uint8_t bottom,
+                                      bool on) {
+  for (uint8_t y = top; y <= bottom && y < height(); y++) {
+    setPixel(x, y, on);
+  }
+}
+
+// Sends the glyph rows that changed since the last update, in runs over
+// consecutive CGRAM addresses planned like a flush of the display.
+void LiquidCrystal_Canvas::update() {
+  uint8_t address = _lcd._address;
+  LiquidCrystal_Base::Run run;
+  _lcd.startRun(run);
+  for (uint8_t i = 0; i < _cols * _rows * 8; i++) {
+    uint8_t cgram = (_glyphs[i >> 3] << 3) | (i & 7);
+    _lcd.runCell(run, 0x80 | cgram, _bitmap[i],
+                 _dirty[i >> 3] & (1 << (i & 7)));
+  }
+  memset(_dirty, 0, sizeof(_dirty));
+
+  if (run.sent) {
+    _lcd.endRun(run.mode);
+    _lcd._address = address;
+    _lcd.restoreAddress();
+  }
+}
+
+// Puts the cells on the display with the top left one at col, row. Cell
+// columns are shown starting at `first`, wrapping around, which lets a
+// scrolling graph move by a whole cell without redrawing the bitmap.
+void LiquidCrystal_Canvas::show(uint8_t col, uint8_t row, uint8_t first) {
+  for (uint8_t r = 0; r < _rows; r++) {
+    _lcd.setCursor(col, row + r);
+    for (uint8_t c = 0; c < _cols; c++) {
+      _lcd.sendChar(_glyphs[r * _cols + (first + c) % _cols]);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef LiquidCrystal_Canvas_h
+#define LiquidCrystal_Canvas_h
+
+#include "LiquidCrystal.h"
+
+#if LCD_ENABLE_CGRAM
+
+// A small bitmap drawn with custom characters: cols x rows cells of 5x8
+// pixels, each one a CGRAM location from reserveChar(), so at most 8 cells,
+// e.g. 8x1 for 40x8 pixels or 4x2 for 20x16. Drawing only changes the
+// bitmap; update() then sends the glyph rows that changed, and show() puts
+// the cells on the display.
+//
+//   LiquidCrystal_Canvas canvas(lcd, 8, 1);
+//   canvas.begin();
+//   canvas.show(4, 1);
+//   canvas.line(0, 7, 39, 0);
+//   canvas.update();
+//
+// The display shows a 1-pixel gap between cells that isn't on the canvas.
+class LiquidCrystal_Canvas {
+public:
+  LiquidCrystal_Canvas(LiquidCrystal_Base &lcd, uint8_t cols, uint8_t rows);
+
+  bool begin();
+  void end();
+
+  uint8_t width() const { return _cols * 5; }
+  uint8_t height() const { return _rows * 8; }
+
+  void clear();
+  void setPixel(uint8_t x, uint8_t y, bool on = true);
+  bool pixel(uint8_t x, uint8_t y) const;
+  void line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool on = true);
+  void fillColumn(uint8_t x, uint8_t top, uint8_t bottom, bool on = true);
+
+  void update();
+  void show(uint8_t col, uint8_t row, uint8_t first = 0);
+
+private:
+  LiquidCrystal_Base &_lcd;
+  uint8_t _cols;
+  uint8_t _rows;
+  uint8_t _glyphs[8];  // CGRAM location of each cell, row by row
+  uint8_t _bitmap[64]; // 8 glyph rows per cell
+  uint8_t _dirty[8];   // bit n set: glyph row n of the cell changed
+};
+
+#endif
+#endif
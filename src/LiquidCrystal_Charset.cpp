@@ -0,0 +1,281 @@
+#include "LiquidCrystal.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#if LCD_ENABLE_UTF8
+
+// UTF-8 to character ROM translation for write().
+//
+// Each ROM table is a list of code point ranges sorted by first code point,
+// so a lookup is a binary search over a few dozen entries in flash. Plain
+// ASCII never gets that far.
+
+struct RomRange {
+  uint16_t first; // first code point of the range
+  uint8_t count;  // number of consecutive code points
+  uint8_t code;   // ROM character of the first code point
+};
+
+// HD44780 ROM code A00 (Japanese standard font)
+static const RomRange romA00[] PROGMEM = {
+    {0x00A2, 1, 0xEC},  // cent sign
+    {0x00A3, 1, 0xED},  // pound sign
+    {0x00A5, 1, 0x5C},  // yen sign
+    {0x00B0, 1, 0xDF},  // degree sign (the semi-voiced mark)
+    {0x00B5, 1, 0xE4},  // micro sign
+    {0x00B7, 1, 0xA5},  // middle dot
+    {0x00DF, 1, 0xE2},  // sharp s (drawn as beta)
+    {0x00E4, 1, 0xE1},  // a umlaut
+    {0x00F1, 1, 0xEE},  // n tilde
+    {0x00F6, 1, 0xEF},  // o umlaut
+    {0x00F7, 1, 0xFD},  // division sign
+    {0x00FC, 1, 0xF5},  // u umlaut
+    {0x03A3, 1, 0xF6},  // capital sigma
+    {0x03A9, 1, 0xF4},  // capital omega
+    {0x03B1, 1, 0xE0},  // alpha
+    {0x03B2, 1, 0xE2},  // beta
+    {0x03B5, 1, 0xE3},  // epsilon
+    {0x03B8, 1, 0xF2},  // theta
+    {0x03BC, 1, 0xE4},  // mu
+    {0x03C0, 1, 0xF7},  // pi
+    {0x03C1, 1, 0xE6},  // rho
+    {0x03C3, 1, 0xE5},  // sigma
+    {0x2190, 1, 0x7F},  // left arrow
+    {0x2192, 1, 0x7E},  // right arrow
+    {0x221A, 1, 0xE8},  // square root
+    {0x221E, 1, 0xF3},  // infinity
+    {0x2588, 1, 0xFF},  // full block
+    {0x4E07, 1, 0xFB},  // ten thousand
+    {0x5343, 1, 0xFA},  // thousand
+    {0x5186, 1, 0xFC},  // yen
+    {0xFF61, 63, 0xA1}, // halfwidth katakana
+};
+
+// HD44780 ROM code A02 (European standard font)
+static const RomRange romA02[] PROGMEM = {
+    {0x00A1, 7, 0xA1},  // inverted exclamation mark .. section sign
+    {0x00A9, 3, 0xA9},  // copyright .. left guillemet
+    {0x00AE, 1, 0xAE},  // registered sign
+    {0x00B0, 4, 0xB0},  // degree sign .. superscript three
+    {0x00B5, 3, 0xB5},  // micro sign .. middle dot
+    {0x00B9, 31, 0xB9}, // superscript one .. multiplication sign
+    {0x00D9, 31, 0xD9}, // U grave .. division sign
+    {0x00F9, 7, 0xF9},  // u grave .. y umlaut
+    {0x0192, 1, 0xA8},  // f hook
+    {0x0393, 1, 0x92},  // capital gamma
+    {0x0398, 1, 0x99},  // capital theta
+    {0x03A3, 1, 0x94},  // capital sigma
+    {0x03A6, 1, 0xD8},  // capital phi
+    {0x03A9, 1, 0x9A},  // capital omega
+    {0x03B1, 1, 0x90},  // alpha
+    {0x03B4, 1, 0x9B},  // delta
+    {0x03B5, 1, 0x9E},  // epsilon
+    {0x03BC, 1, 0xB5},  // mu
+    {0x03C0, 1, 0x93},  // pi
+    {0x03C3, 1, 0x95},  // sigma
+    {0x03C4, 1, 0x97},  // tau
+    {0x03C6, 1, 0xF8},  // phi
+    {0x03C9, 1, 0xB8},  // omega
+    {0x0411, 1, 0x80},  // Cyrillic BE
+    {0x0414, 1, 0x81},  // Cyrillic DE
+    {0x0416, 4, 0x82},  // Cyrillic ZHE .. SHORT I
+    {0x041B, 1, 0x86},  // Cyrillic EL
+    {0x041F, 1, 0x87},  // Cyrillic PE
+    {0x0423, 1, 0x88},  // Cyrillic U
+    {0x0426, 6, 0x89},  // Cyrillic TSE .. YERU
+    {0x042D, 1, 0x8F},  // Cyrillic E
+    {0x042E, 2, 0xAC},  // Cyrillic YU, YA
+    {0x2018, 1, 0xAF},  // left single quotation mark
+    {0x20A7, 1, 0xB4},  // peseta sign
+    {0x221E, 1, 0x9C},  // infinity
+    {0x2229, 1, 0x9F},  // intersection
+    {0x2665, 1, 0x9D},  // heart
+    {0x266A, 1, 0x91},  // eighth note
+};
+
+// marks a 4-byte sequence, which can't be on either ROM
+#define UTF8_UNMAPPABLE 0xFFFD
+
+// Sets `code` to the ROM character for a code point. Returns false if the
+// ROM has none; every byte, 0xFF included, is a character of its own.
+static bool lookupRom(const RomRange *table, uint8_t size, uint16_t codepoint,
+                      uint8_t &code) {
+  // find the first range starting after the code point
+  uint8_t low = 0;
+  uint8_t high = size;
+  while (low < high) {
+    uint8_t middle = (low + high) / 2;
+    if (codepoint < pgm_read_word(&table[middle].first)) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+  if (low == 0) {
+    return false;
+  }
+
+  const RomRange *range = &table[low - 1];
+  uint16_t offset = codepoint - pgm_read_word(&range->first);
+  if (offset >= pgm_read_byte(&range->count)) {
+    return false;
+  }
+  code = pgm_read_byte(&range->code) + offset;
+  return true;
+}
+
+#if LCD_ENABLE_CGRAM
+// Sets the custom characters translation may load for code points missing
+// from the ROM. The table lives in PROGMEM, sorted by code point, and at most
+// `slots` CGRAM locations are taken from reserveChar() to show them. When
+// more distinct glyphs are in use than that, the locations are taken back
+// round-robin, in location order rather than by age or use, which also
+// changes the old glyph wherever it is still on the display.
+void LiquidCrystal_Base::setGlyphs(const LiquidCrystal_Glyph *glyphs,
+                                   uint8_t count, uint8_t slots) {
+  for (uint8_t location = 0; location < 8; location++) {
+    if (_glyph_owned & (1 << location)) {
+      releaseChar(location);
+    }
+  }
+  _glyphs = glyphs;
+  _glyph_count = count;
+  _glyph_slots = slots;
+  _glyph_owned = 0;
+  _glyph_next = 0;
+}
+
+// Returns the CGRAM location showing the glyph for a code point, loading it
+// first if needed, or LCD_NOCHAR if there is no glyph for it.
+uint8_t LiquidCrystal_Base::lookupGlyph(uint16_t codepoint) {
+  uint8_t location;
+  for (location = 0; location < 8; location++) {
+    if ((_glyph_owned & (1 << location)) &&
+        _glyph_codepoint[location] == codepoint) {
+      return location;
+    }
+  }
+
+  uint8_t low = 0;
+  uint8_t high = _glyph_count;
+  while (low < high) {
+    uint8_t middle = (low + high) / 2;
+    uint16_t found = pgm_read_word(&_glyphs[middle].codepoint);
+    if (found == codepoint) {
+      low = middle;
+      break;
+    } else if (codepoint < found) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+  if (low >= high) {
+    return LCD_NOCHAR;
+  }
+
+  // take another location while we are allowed to, otherwise replace the
+  // glyphs we loaded in turn
+  uint8_t owned = 0;
+  for (location = 0; location < 8; location++) {
+    if (_glyph_owned & (1 << location)) {
+      owned++;
+    }
+  }
+  location = LCD_NOCHAR;
+  if (owned < _glyph_slots) {
+    location = reserveChar();
+  }
+  if (location == LCD_NOCHAR) {
+    if (!_glyph_owned) {
+      return LCD_NOCHAR;
+    }
+    do {
+      location = _glyph_next;
+      _glyph_next = (_glyph_next + 1) & 0x7;
+    } while (!(_glyph_owned & (1 << location)));
+  }
+  _glyph_owned |= 1 << location;
+  _glyph_codepoint[location] = codepoint;
+
+  // loading the glyph moves the address counter into CGRAM, so put it back
+  uint8_t address = _address;
+  uint8_t charmap[8];
+  memcpy_P(charmap, _glyphs[low].charmap, sizeof(charmap));
+  createChar(location, charmap);
+  _address = address;
+  restoreAddress();
+  return location;
+}
+#endif
+
+// Decodes one byte of UTF-8 with the decoder `utf8`. Returns false in the
+// middle of a sequence, otherwise replaces the byte with the ROM (or CGRAM)
+// character to send. Code points neither table covers come out as '?'.
+bool LiquidCrystal_Base::translate(uint8_t &value, LiquidCrystal_Utf8 &utf8) {
+  if (_rom == LCD_ROM_RAW) {
+    return true;
+  }
+
+  uint16_t codepoint;
+  if (value < 0x80) {
+    utf8.pending = 0;
+    // A00 has a yen sign and an arrow where ASCII has '\' and '~'
+    if (_rom != LCD_ROM_A00 || (value != '\\' && value != '~')) {
+      return true;
+    }
+    codepoint = value;
+  } else if ((value & 0xC0) == 0x80) {
+    if (!utf8.pending) {
+      value = '?'; // continuation byte without a lead byte
+      return true;
+    }
+    if (utf8.codepoint != UTF8_UNMAPPABLE) {
+      utf8.codepoint = (utf8.codepoint << 6) | (value & 0x3F);
+    }
+    if (--utf8.pending) {
+      return false;
+    }
+    codepoint = utf8.codepoint;
+  } else {
+    if ((value & 0xE0) == 0xC0) {
+      utf8.codepoint = value & 0x1F;
+      utf8.pending = 1;
+    } else if ((value & 0xF0) == 0xE0) {
+      utf8.codepoint = value & 0x0F;
+      utf8.pending = 2;
+    } else {
+      utf8.codepoint = UTF8_UNMAPPABLE;
+      utf8.pending = 3;
+    }
+    return false;
+  }
+
+  if (codepoint >= 0x80 && codepoint != UTF8_UNMAPPABLE) {
+    bool found;
+    if (_rom == LCD_ROM_A00) {
+      found = lookupRom(romA00, sizeof(romA00) / sizeof(*romA00), codepoint,
+                        value);
+    } else {
+      found = lookupRom(romA02, sizeof(romA02) / sizeof(*romA02), codepoint,
+                        value);
+    }
+    if (found) {
+      return true;
+    }
+  }
+  uint8_t code = LCD_NOCHAR;
+#if LCD_ENABLE_CGRAM
+  if (_glyphs) {
+    code = lookupGlyph(codepoint); // LCD_NOCHAR: no glyph, or no room
+  }
+#endif
+  if (code == LCD_NOCHAR) {
+    code = (codepoint < 0x80) ? codepoint : '?';
+  }
+  value = code;
+  return true;
+}
+
+#endif
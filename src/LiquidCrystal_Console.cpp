@@ -0,0 +1,96 @@
+#include "LiquidCrystal_Console.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+LiquidCrystal_Console::LiquidCrystal_Console(LiquidCrystal_Base &lcd,
+                                             uint8_t *buffer, uint8_t cols,
+                                             uint8_t rows)
+    : _lcd(lcd), _buffer(buffer), _cols(cols), _rows(rows) {
+  memset(_buffer, ' ', _cols * _rows);
+  _col = _row = 0;
+  _placed = false;
+}
+
+// the buffer is drawn as a whole frame, so it must be the display's size
+bool LiquidCrystal_Console::fits() const {
+  return _cols == _lcd._cols && _rows == _lcd._numlines;
+}
+
+// Blanks the display and goes to the top row. Call it once after begin().
+// Returns false if the console isn't the size of the display.
+bool LiquidCrystal_Console::clear() {
+  if (!fits()) {
+    return false;
+  }
+  memset(_buffer, ' ', _cols * _rows);
+  _lcd.drawFrame(_buffer);
+  _col = _row = 0;
+  _placed = false;
+  return true;
+}
+
+// Moves every row up one and blanks the bottom one. A row is rewritten only
+// where it differs from the row that was below it, so runs of similar log
+// lines, or short ones, cost little.
+void LiquidCrystal_Console::scroll() {
+  if (!fits()) {
+    return;
+  }
+  memmove(_buffer, _buffer + _cols, _cols * (_rows - 1));
+  memset(_buffer + _cols * (_rows - 1), ' ', _cols);
+  _lcd.drawFrame(_buffer);
+  _placed = false;
+}
+
+void LiquidCrystal_Console::newline() {
+  _col = 0;
+  if (_row + 1 < _rows) {
+    _row++;
+  } else {
+    scroll();
+  }
+  _placed = false;
+}
+
+// '\b' blanks the character before the cursor and moves back onto it. Other
+// characters are translated like the display does.
+size_t LiquidCrystal_Console::write(uint8_t value) {
+  if (!fits()) {
+    return 0;
+  }
+  if (value == '\r') {
+    _col = 0;
+    _placed = false;
+    return 1;
+  }
+  if (value == '\n') {
+    newline();
+    return 1;
+  }
+  if (value == '\b') {
+    if (_col > 0) {
+      _col--;
+      _buffer[_row * _cols + _col] = ' ';
+      _lcd.setCursor(_col, _row);
+      _lcd.sendChar(' ');
+      _placed = false;
+    }
+    return 1;
+  }
+  if (!_lcd.translate(value)) {
+    return 1;
+  }
+
+  if (_col >= _cols) {
+    newline();
+  }
+  if (!_placed) {
+    _lcd.setCursor(_col, _row);
+    _placed = true;
+  }
+  _lcd.sendChar(value);
+  _buffer[_row * _cols + _col] = value;
+  _col++;
+  return 1;
+}
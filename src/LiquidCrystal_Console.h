@@ -0,0 +1,47 @@
+#ifndef LiquidCrystal_Console_h
+#define LiquidCrystal_Console_h
+
+#include "LiquidCrystal.h"
+
+// A terminal on the display for event logs. Text goes on at once, one row
+// after the other whatever the rows' DDRAM addresses; '\r' goes back to the
+// start of the row, '\n' on to the next one, '\b' back over the last
+// character, and a full row wraps. Past the bottom row the rows scroll up,
+// and only the cells whose character changes are rewritten.
+//
+//   uint8_t shadow[20 * 4], log[20 * 4];
+//   LiquidCrystal_Console console(lcd, log, 20, 4);
+//
+//   lcd.begin(20, 4);
+//   lcd.attachShadow(shadow);
+//   console.clear();
+//   console.println("E12 fan stalled");
+//
+// Without a shadow attached to the display, scrolling redraws every cell.
+// The console expects to be the only one writing to the display, and to
+// have its geometry; it draws nothing on a display of another size.
+class LiquidCrystal_Console : public Print {
+public:
+  LiquidCrystal_Console(LiquidCrystal_Base &lcd, uint8_t *buffer,
+                        uint8_t cols, uint8_t rows);
+
+  bool clear();
+  void scroll();
+
+  virtual size_t write(uint8_t);
+  using Print::write;
+
+private:
+  bool fits() const;
+  void newline();
+
+  LiquidCrystal_Base &_lcd;
+  uint8_t *_buffer; // what the console shows, cols x rows
+  uint8_t _cols;
+  uint8_t _rows;
+  uint8_t _col; // _cols after a full row: it wraps with the next character
+  uint8_t _row;
+  bool _placed; // the display's cursor is at _col, _row
+};
+
+#endif
@@ -0,0 +1,62 @@
+#include "LiquidCrystal_Format.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+// Writes a number right-aligned (or left with LCD_FORMAT_LEFT) in exactly
+// `width` characters, with a decimal point before the last `point` digits.
+void lcdRenderNumber(char *out, uint8_t width, uint8_t flags,
+                     uint32_t magnitude, bool negative, uint8_t base,
+                     uint8_t point) {
+  char digits[12]; // least significant first
+  uint8_t count = 0;
+  do {
+    uint8_t digit = magnitude % base;
+    digits[count++] = (digit < 10) ? '0' + digit
+                      : (flags & LCD_FORMAT_UPPER) ? 'A' + digit - 10
+                                                   : 'a' + digit - 10;
+    magnitude /= base;
+    if (count == point) {
+      digits[count++] = '.';
+    }
+  } while (magnitude || (point && count <= point + 1));
+
+  char sign = negative ? '-' : (flags & LCD_FORMAT_PLUS) ? '+' : 0;
+  uint8_t length = count + (sign ? 1 : 0);
+  if (length > width) {
+    lcdRenderOverflow(out, width);
+    return;
+  }
+
+  uint8_t pad = width - length;
+  if (!(flags & (LCD_FORMAT_LEFT | LCD_FORMAT_ZERO))) {
+    memset(out, ' ', pad);
+    out += pad;
+  }
+  if (sign) {
+    *out++ = sign;
+  }
+  if ((flags & LCD_FORMAT_ZERO) && !(flags & LCD_FORMAT_LEFT)) {
+    memset(out, '0', pad);
+    out += pad;
+  }
+  while (count) {
+    *out++ = digits[--count];
+  }
+  if (flags & LCD_FORMAT_LEFT) {
+    memset(out, ' ', pad);
+  }
+}
+
+void lcdRenderOverflow(char *out, uint8_t width) { memset(out, '#', width); }
+
+// copies `count` characters of format text from flash, "%%" as one '%'
+void lcdRenderText(char *out, PGM_P text, uint8_t count) {
+  while (count--) {
+    char c = pgm_read_byte(text++);
+    if (c == '%') {
+      text++;
+    }
+    *out++ = c;
+  }
+}
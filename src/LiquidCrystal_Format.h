@@ -0,0 +1,205 @@
+#ifndef LiquidCrystal_Format_h
+#define LiquidCrystal_Format_h
+
+#include "LiquidCrystal.h"
+
+// printf-style formatting of one value into a fixed-width field, with the
+// format parsed by the compiler:
+//
+//   lcd.setCursor(0, 0);
+//   LCD_PRINTF(lcd, "Temp %5.1f C", temperature);
+//   LCD_PRINTF(lcd, "RH %3d%%", humidity);
+//
+// The format has one conversion, %d, %i, %u, %x, %X or %f, with an optional
+// '-' (left-justify), '0' (zero-pad) or '+' flag and a width, which is
+// required: the field is always exactly that wide, so a shorter value
+// clears what a longer one left behind. A value too wide for its field
+// shows as #s rather than push the text after it along. The text around
+// the conversion stays in flash. There is no vfprintf and no parsing at run
+// time, and on a display the characters that already show are skipped
+// (see writeChanged()). Any other Print works too.
+#define LCD_PRINTF(out, format, value)                                         \
+  LiquidCrystal_Format<lcdFormatPrefix(format), lcdFormatFlags(format),       \
+                       lcdFormatWidth(format), lcdFormatPrecision(format),    \
+                       lcdFormatType(format), lcdFormatSuffix(format),        \
+                       lcdFormatSuffixAt(format),                             \
+                       lcdFormatError(format)>::print(out, PSTR(format),     \
+                                                       value)
+
+#define LCD_FORMAT_LEFT 0x01
+#define LCD_FORMAT_ZERO 0x02
+#define LCD_FORMAT_PLUS 0x04
+#define LCD_FORMAT_UPPER 0x08
+
+// the parser; every function looks at the character at `i` and recurses
+// on, the only way C++11 constexpr allows
+
+// where the conversion starts, past any "%%"
+constexpr uint8_t lcdFormatStart(const char *f, uint8_t i = 0) {
+  return (!f[i] || (f[i] == '%' && f[i + 1] != '%'))
+             ? i
+             : lcdFormatStart(f, i + ((f[i] == '%') ? 2 : 1));
+}
+
+constexpr uint8_t lcdFormatFlagsAt(const char *f, uint8_t i,
+                                   uint8_t flags = 0) {
+  return (f[i] == '-')   ? lcdFormatFlagsAt(f, i + 1, flags | LCD_FORMAT_LEFT)
+         : (f[i] == '0') ? lcdFormatFlagsAt(f, i + 1, flags | LCD_FORMAT_ZERO)
+         : (f[i] == '+') ? lcdFormatFlagsAt(f, i + 1, flags | LCD_FORMAT_PLUS)
+                         : flags;
+}
+
+constexpr uint8_t lcdFormatSkipFlags(const char *f, uint8_t i) {
+  return (f[i] == '-' || f[i] == '0' || f[i] == '+')
+             ? lcdFormatSkipFlags(f, i + 1)
+             : i;
+}
+
+constexpr uint8_t lcdFormatNumber(const char *f, uint8_t i, uint8_t n = 0) {
+  return (f[i] >= '0' && f[i] <= '9')
+             ? lcdFormatNumber(f, i + 1, n * 10 + f[i] - '0')
+             : n;
+}
+
+constexpr uint8_t lcdFormatSkipDigits(const char *f, uint8_t i) {
+  return (f[i] >= '0' && f[i] <= '9') ? lcdFormatSkipDigits(f, i + 1) : i;
+}
+
+constexpr uint8_t lcdFormatSkipLong(const char *f, uint8_t i) {
+  return (f[i] == 'l') ? lcdFormatSkipLong(f, i + 1) : i;
+}
+
+// where the width, the precision and the type are
+constexpr uint8_t lcdFormatWidthAt(const char *f) {
+  return lcdFormatSkipFlags(f, lcdFormatStart(f) + 1);
+}
+constexpr uint8_t lcdFormatDotAt(const char *f) {
+  return lcdFormatSkipDigits(f, lcdFormatWidthAt(f));
+}
+constexpr uint8_t lcdFormatTypeAt(const char *f) {
+  return lcdFormatSkipLong(
+      f, (f[lcdFormatDotAt(f)] == '.')
+             ? lcdFormatSkipDigits(f, lcdFormatDotAt(f) + 1)
+             : lcdFormatDotAt(f));
+}
+
+// how many characters the text from i to the end or the next conversion
+// shows, with "%%" as one
+constexpr uint8_t lcdFormatLiteral(const char *f, uint8_t i, uint8_t n = 0) {
+  return (!f[i] || (f[i] == '%' && f[i + 1] != '%'))
+             ? n
+             : lcdFormatLiteral(f, i + ((f[i] == '%') ? 2 : 1), n + 1);
+}
+
+constexpr uint8_t lcdFormatPrefix(const char *f) {
+  return lcdFormatLiteral(f, 0);
+}
+constexpr uint8_t lcdFormatFlags(const char *f) {
+  return !f[lcdFormatStart(f)]
+             ? 0
+             : lcdFormatFlagsAt(f, lcdFormatStart(f) + 1) |
+                   ((f[lcdFormatTypeAt(f)] == 'X') ? LCD_FORMAT_UPPER : 0);
+}
+constexpr uint8_t lcdFormatWidth(const char *f) {
+  return !f[lcdFormatStart(f)] ? 0 : lcdFormatNumber(f, lcdFormatWidthAt(f));
+}
+constexpr uint8_t lcdFormatPrecision(const char *f) {
+  return !f[lcdFormatStart(f)]           ? 0
+         : (f[lcdFormatDotAt(f)] == '.') ? lcdFormatNumber(f, lcdFormatDotAt(f) + 1)
+         : (f[lcdFormatTypeAt(f)] == 'f') ? 6
+                                          : 0;
+}
+constexpr char lcdFormatType(const char *f) {
+  return f[lcdFormatStart(f)] ? f[lcdFormatTypeAt(f)] : 0;
+}
+// where the text after the conversion starts
+constexpr uint8_t lcdFormatSuffixAt(const char *f) {
+  return f[lcdFormatStart(f)] ? lcdFormatTypeAt(f) + 1 : lcdFormatStart(f);
+}
+constexpr uint8_t lcdFormatSuffix(const char *f) {
+  return lcdFormatLiteral(f, lcdFormatSuffixAt(f));
+}
+
+// 0, or why the format can't be used; see the static_asserts below
+constexpr uint8_t lcdFormatError(const char *f) {
+  return !f[lcdFormatStart(f)]                                     ? 1
+         : (lcdFormatType(f) != 'd' && lcdFormatType(f) != 'i' &&
+            lcdFormatType(f) != 'u' && lcdFormatType(f) != 'x' &&
+            lcdFormatType(f) != 'X' && lcdFormatType(f) != 'f')     ? 2
+         : !lcdFormatWidth(f)                                       ? 3
+         : lcdFormatPrecision(f) > 9                                ? 4
+         : f[lcdFormatStart(f, lcdFormatTypeAt(f) + 1)]             ? 5
+                                                                    : 0;
+}
+
+constexpr uint32_t lcdFormatPow10(uint8_t n) {
+  return n ? 10 * lcdFormatPow10(n - 1) : 1;
+}
+
+// the run-time part, shared by every format
+void lcdRenderNumber(char *out, uint8_t width, uint8_t flags,
+                     uint32_t magnitude, bool negative, uint8_t base,
+                     uint8_t point);
+void lcdRenderOverflow(char *out, uint8_t width);
+void lcdRenderText(char *out, PGM_P text, uint8_t count);
+
+template <uint8_t Prefix, uint8_t Flags, uint8_t Width, uint8_t Precision,
+          char Type, uint8_t Suffix, uint8_t SuffixAt, uint8_t Error>
+class LiquidCrystal_Format {
+  static_assert(Error != 1, "LCD_PRINTF: the format has no conversion");
+  static_assert(Error != 2, "LCD_PRINTF: use %d, %i, %u, %x, %X or %f");
+  static_assert(Error != 3, "LCD_PRINTF: give the field a width, like %5d");
+  static_assert(Error != 4, "LCD_PRINTF: at most 9 decimals");
+  static_assert(Error != 5, "LCD_PRINTF: only one conversion per format");
+
+public:
+  static const uint8_t size = Prefix + Width + Suffix;
+
+  template <typename T> static size_t print(Print &out, PGM_P f, T value) {
+    char text[size];
+    render(text, f, value);
+    return out.write(reinterpret_cast<const uint8_t *>(text), size);
+  }
+
+  template <typename T>
+  static size_t print(LiquidCrystal_Base &lcd, PGM_P f, T value) {
+    char text[size];
+    render(text, f, value);
+    return lcd.writeChanged(reinterpret_cast<const uint8_t *>(text), size);
+  }
+
+private:
+  template <typename T> static void render(char *text, PGM_P f, T value) {
+    lcdRenderText(text, f, Prefix);
+    char *field = text + Prefix;
+    if (Type == 'f') {
+      double number = value;
+      double scaled = (number < 0 ? -number : number) *
+                          lcdFormatPow10(Precision) +
+                      0.5;
+      if (!(scaled < 4294967295.0)) {
+        lcdRenderOverflow(field, Width); // and NaN
+      } else {
+        uint32_t magnitude = scaled;
+        lcdRenderNumber(field, Width, Flags, magnitude,
+                        number < 0 && magnitude, 10, Precision);
+      }
+    } else if (Type == 'd' || Type == 'i') {
+      long number = value;
+      lcdRenderNumber(field, Width, Flags,
+                      number < 0 ? 0UL - (uint32_t)number : number,
+                      number < 0, 10, 0);
+    } else {
+      // the bits of the argument's own type, like printf's promotion
+      uint32_t bits = (uint32_t)(long)value;
+      if (sizeof(T) < sizeof(uint32_t)) {
+        bits &= (1UL << (8 * sizeof(T) % 32)) - 1;
+      }
+      lcdRenderNumber(field, Width, Flags, bits, false,
+                      (Type == 'u') ? 10 : 16, 0);
+    }
+    lcdRenderText(field + Width, f + SuffixAt, Suffix);
+  }
+};
+
+#endif
@@ -0,0 +1,148 @@
+#include "LiquidCrystal_Mirror.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+LiquidCrystal_Mirror::LiquidCrystal_Mirror(LiquidCrystal_Base &lcd,
+                                           Stream &stream, uint16_t interval)
+    : _lcd(lcd), _stream(stream) {
+  _interval = interval;
+  _last = 0;
+  _keyframe = true;
+  _check = 0;
+}
+
+// Starts marking changed cells. Returns false if the display has no shadow
+// or more cells than LCD_MIRROR_MAXCELLS.
+bool LiquidCrystal_Mirror::begin() {
+  uint8_t rows = (_lcd._numlines < 4) ? _lcd._numlines : 4;
+  if (!_lcd._shadow || _lcd._cols * rows > LCD_MIRROR_MAXCELLS) {
+    return false;
+  }
+  memset(_dirty, 0, sizeof(_dirty));
+  _lcd._dirty = _dirty;
+#if LCD_ENABLE_CGRAM
+  _lcd._cgram_dirty = 0;
+#endif
+  _keyframe = true;
+  return true;
+}
+
+void LiquidCrystal_Mirror::end() {
+  if (_lcd._dirty == _dirty) {
+    _lcd._dirty = NULL;
+  }
+}
+
+// Sends what changed since the last update, if `interval` ms have passed and
+// there is anything. Call it every time through loop(). Returns true if it
+// sent something. Only a 'K' at the front of the stream is read, so the
+// sketch can share the stream for input of its own.
+bool LiquidCrystal_Mirror::update() {
+  while (_stream.available() && _stream.peek() == LCD_MIRROR_KEYFRAME) {
+    _stream.read();
+    _keyframe = true;
+  }
+  // the shadow may have been detached since begin()
+  if (_lcd._dirty != _dirty || !_lcd._shadow ||
+      millis() - _last < _interval) {
+    return false;
+  }
+
+  if (_keyframe) {
+    sendKeyframe();
+    _last = millis();
+    return true;
+  }
+
+  bool sent = false;
+#if LCD_ENABLE_CGRAM
+  if (_lcd._cgram_dirty && _lcd._cgram_cache) {
+    for (uint8_t location = 0; location < 8; location++) {
+      if (_lcd._cgram_dirty & (1 << location)) {
+        sendGlyph(location);
+      }
+    }
+    sent = true;
+  }
+  _lcd._cgram_dirty = 0;
+#endif
+
+  // a byte of the bitmap at a time, so unchanged stretches cost little
+  uint8_t rows = (_lcd._numlines < 4) ? _lcd._numlines : 4;
+  uint8_t cells = _lcd._cols * rows;
+  uint8_t cell = 0;
+  while (cell < cells) {
+    if (!_dirty[cell >> 3]) {
+      cell = (cell | 7) + 1;
+      continue;
+    }
+    if (!(_dirty[cell >> 3] & (1 << (cell & 7)))) {
+      cell++;
+      continue;
+    }
+    uint8_t first = cell;
+    while (cell < cells && (_dirty[cell >> 3] & (1 << (cell & 7)))) {
+      _dirty[cell >> 3] &= ~(1 << (cell & 7));
+      cell++;
+    }
+    startPacket(LCD_MIRROR_RUN, 1 + cell - first);
+    put(first);
+    for (uint8_t i = first; i < cell; i++) {
+      put(_lcd._shadow[i]);
+    }
+    endPacket();
+    sent = true;
+  }
+  if (sent) {
+    _last = millis();
+  }
+  return sent;
+}
+
+void LiquidCrystal_Mirror::sendKeyframe() {
+  uint8_t rows = (_lcd._numlines < 4) ? _lcd._numlines : 4;
+  uint8_t cells = _lcd._cols * rows;
+  startPacket(LCD_MIRROR_KEYFRAME, 2 + cells);
+  put(_lcd._cols);
+  put(rows);
+  for (uint8_t i = 0; i < cells; i++) {
+    put(_lcd._shadow[i]);
+  }
+  endPacket();
+  memset(_dirty, 0, sizeof(_dirty));
+  _keyframe = false;
+#if LCD_ENABLE_CGRAM
+  if (_lcd._cgram_cache) {
+    for (uint8_t location = 0; location < 8; location++) {
+      sendGlyph(location);
+    }
+  }
+  _lcd._cgram_dirty = 0;
+#endif
+}
+
+#if LCD_ENABLE_CGRAM
+void LiquidCrystal_Mirror::sendGlyph(uint8_t location) {
+  startPacket(LCD_MIRROR_GLYPH, 9);
+  put(location);
+  for (uint8_t i = 0; i < 8; i++) {
+    put(_lcd._cgram_cache[location * 8 + i]);
+  }
+  endPacket();
+}
+#endif
+
+void LiquidCrystal_Mirror::startPacket(uint8_t type, uint8_t length) {
+  _stream.write((uint8_t)LCD_MIRROR_SYNC);
+  _check = 0;
+  put(type);
+  put(length);
+}
+
+void LiquidCrystal_Mirror::put(uint8_t value) {
+  _stream.write(value);
+  _check ^= value;
+}
+
+void LiquidCrystal_Mirror::endPacket() { _stream.write(_check); }
@@ -0,0 +1,66 @@
+#ifndef LiquidCrystal_Mirror_h
+#define LiquidCrystal_Mirror_h
+
+#include "LiquidCrystal.h"
+#include "Stream.h"
+
+// most cells a mirrored display may have: 20x4 or 40x2; a keyframe must fit
+// in one packet, so no more than 253
+#ifndef LCD_MIRROR_MAXCELLS
+#define LCD_MIRROR_MAXCELLS 80
+#endif
+
+// Every packet is LCD_MIRROR_SYNC, a type, a payload length, the payload and
+// the XOR of the type, length and payload bytes.
+#define LCD_MIRROR_SYNC 0xA5
+#define LCD_MIRROR_KEYFRAME 'K' // cols, rows, every cell
+#define LCD_MIRROR_RUN 'R'      // first cell index, the cells from there on
+#define LCD_MIRROR_GLYPH 'G'    // CGRAM location, its 8 rows
+
+// Sends what the display shows to a Stream, for a technician to watch from
+// somewhere else with scripts/lcd_mirror.py. The display keeps a bitmap of
+// the shadow cells and CGRAM locations that changed, so an update costs
+// what was changed rather than the size of the screen.
+//
+//   uint8_t shadow[16 * 2], cgram[64];
+//   LiquidCrystal_Mirror mirror(lcd, Serial);
+//
+//   lcd.begin(16, 2);
+//   lcd.attachShadow(shadow);
+//   lcd.attachCharCache(cgram); // optional, to mirror custom characters
+//   mirror.begin();
+//   ...
+//   mirror.update(); // in loop()
+//
+// The first update, and the next one after keyframe() or after the other
+// end sends a 'K', sends the whole screen. Nothing is sent while the display
+// has no shadow.
+class LiquidCrystal_Mirror {
+public:
+  LiquidCrystal_Mirror(LiquidCrystal_Base &lcd, Stream &stream,
+                       uint16_t interval = 200);
+
+  bool begin();
+  void end();
+  void keyframe() { _keyframe = true; }
+  bool update();
+
+private:
+  void sendKeyframe();
+#if LCD_ENABLE_CGRAM
+  void sendGlyph(uint8_t location);
+#endif
+  void startPacket(uint8_t type, uint8_t length);
+  void put(uint8_t);
+  void endPacket();
+
+  LiquidCrystal_Base &_lcd;
+  Stream &_stream;
+  uint16_t _interval; // shortest time between updates, in ms
+  unsigned long _last;
+  bool _keyframe;
+  uint8_t _check;
+  uint8_t _dirty[(LCD_MIRROR_MAXCELLS + 7) / 8];
+};
+
+#endif
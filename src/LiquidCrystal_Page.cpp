@@ -0,0 +1,92 @@
+#include "LiquidCrystal_Page.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+LiquidCrystal_Page::LiquidCrystal_Page(LiquidCrystal_Base &lcd,
+                                       uint8_t *buffer, uint8_t cols,
+                                       uint8_t rows)
+    : _lcd(lcd), _buffer(buffer), _cols(cols), _rows(rows) {
+  // the same state begin() leaves the display in
+  _displaycontrol = LCD_DISPLAYON | LCD_CURSOROFF | LCD_BLINKOFF;
+  _displaymode = LCD_ENTRYLEFT | LCD_ENTRYSHIFTDECREMENT;
+#if LCD_ENABLE_UTF8
+  _utf8.pending = 0;
+#endif
+  clear();
+}
+
+// Makes this the page on the display: the differing cells, then the
+// display and entry mode settings if they differ, then the cursor. Returns
+// false, and sends nothing, if the page isn't the size of the display.
+bool LiquidCrystal_Page::show() {
+  if (_cols != _lcd._cols || _rows != _lcd._numlines) {
+    return false;
+  }
+  _lcd.drawFrame(_buffer);
+  if (_lcd._displaycontrol != _displaycontrol) {
+    _lcd._displaycontrol = _displaycontrol;
+    _lcd.command(LCD_DISPLAYCONTROL | _displaycontrol);
+  }
+  if (_lcd._displaymode != _displaymode) {
+    _lcd._displaymode = _displaymode;
+    _lcd.command(LCD_ENTRYMODESET | _displaymode);
+  }
+  // a cursor run off the page shows at the edge it ran off
+  uint8_t col = _col;
+  if (col == 0xFF) {
+    col = 0;
+  } else if (col >= _cols) {
+    col = _cols - 1;
+  }
+  _lcd.setCursor(col, _row);
+  return true;
+}
+
+void LiquidCrystal_Page::clear() {
+  memset(_buffer, ' ', _cols * _rows);
+  _col = _row = 0;
+  _displaymode |= LCD_ENTRYLEFT; // like the display's clear command
+}
+
+void LiquidCrystal_Page::home() { _col = _row = 0; }
+
+void LiquidCrystal_Page::setCursor(uint8_t col, uint8_t row) {
+  if (row >= _rows) {
+    row = _rows - 1; // we count rows starting w/ 0
+  }
+  _col = col;
+  _row = row;
+}
+
+void LiquidCrystal_Page::noDisplay() { _displaycontrol &= ~LCD_DISPLAYON; }
+void LiquidCrystal_Page::display() { _displaycontrol |= LCD_DISPLAYON; }
+void LiquidCrystal_Page::noCursor() { _displaycontrol &= ~LCD_CURSORON; }
+void LiquidCrystal_Page::cursor() { _displaycontrol |= LCD_CURSORON; }
+void LiquidCrystal_Page::noBlink() { _displaycontrol &= ~LCD_BLINKON; }
+void LiquidCrystal_Page::blink() { _displaycontrol |= LCD_BLINKON; }
+void LiquidCrystal_Page::leftToRight() { _displaymode |= LCD_ENTRYLEFT; }
+void LiquidCrystal_Page::rightToLeft() { _displaymode &= ~LCD_ENTRYLEFT; }
+
+// Characters that would land off the page are dropped, where the display
+// would put them in DDRAM it doesn't show; the cursor stays off the page,
+// at _cols or 0xFF left of it, until it is moved back. UTF-8 is translated like the display
+// does, but with a decoder of the page's own; loading a glyph for it is the
+// only time this uses the bus.
+size_t LiquidCrystal_Page::write(uint8_t value) {
+#if LCD_ENABLE_UTF8
+  if (!_lcd.translate(value, _utf8)) {
+    return 1;
+  }
+#endif
+  if (_col >= _cols) {
+    return 1;
+  }
+  _buffer[_row * _cols + _col] = value;
+  if (_displaymode & LCD_ENTRYLEFT) {
+    _col++;
+  } else {
+    _col--;
+  }
+  return 1;
+}
@@ -0,0 +1,60 @@
+#ifndef LiquidCrystal_Page_h
+#define LiquidCrystal_Page_h
+
+#include "LiquidCrystal.h"
+
+// An off-screen copy of the display with its own cursor and display/entry
+// mode settings. Printing to a page only changes its buffer; show() then
+// brings the display to the page, sending only the cells that differ from
+// what is showing.
+//
+//   uint8_t shadow[16 * 2], menu[16 * 2], status[16 * 2];
+//   LiquidCrystal_Page menuPage(lcd, menu, 16, 2);
+//   LiquidCrystal_Page statusPage(lcd, status, 16, 2);
+//
+//   lcd.begin(16, 2);
+//   lcd.attachShadow(shadow);
+//   menuPage.print("> Settings");
+//   menuPage.show();
+//
+// Without a shadow attached to the display, show() redraws every cell. A
+// page has the display's geometry; show() draws nothing on one that doesn't.
+class LiquidCrystal_Page : public Print {
+public:
+  LiquidCrystal_Page(LiquidCrystal_Base &lcd, uint8_t *buffer, uint8_t cols,
+                     uint8_t rows);
+
+  bool show();
+
+  void clear();
+  void home();
+  void setCursor(uint8_t, uint8_t);
+  void noDisplay();
+  void display();
+  void noBlink();
+  void blink();
+  void noCursor();
+  void cursor();
+  void leftToRight();
+  void rightToLeft();
+
+  virtual size_t write(uint8_t);
+  using Print::write;
+
+  uint8_t *buffer() { return _buffer; }
+
+private:
+  LiquidCrystal_Base &_lcd;
+  uint8_t *_buffer;
+  uint8_t _cols;
+  uint8_t _rows;
+  uint8_t _col;
+  uint8_t _row;
+  uint8_t _displaycontrol;
+  uint8_t _displaymode;
+#if LCD_ENABLE_UTF8
+  LiquidCrystal_Utf8 _utf8;
+#endif
+};
+
+#endif
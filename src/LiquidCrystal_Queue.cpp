@@ -0,0 +1,111 @@
+#include "LiquidCrystal_Queue.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#define QUEUE_MASK (LCD_QUEUE_SIZE - 1)
+
+LiquidCrystal_Queue::LiquidCrystal_Queue(LiquidCrystal_Base &lcd)
+    : _lcd(lcd), _head(0), _tail(0), _dropped(0) {}
+
+bool LiquidCrystal_Queue::push(uint8_t col, uint8_t row, const char *text) {
+  size_t length = strlen(text);
+  if (length > LCD_PATCH_LENGTH) {
+    length = LCD_PATCH_LENGTH; // before it is narrowed to a uint8_t
+  }
+  return push(col, row, (const uint8_t *)text, length);
+}
+
+// Queues text for (col, row), cut to LCD_PATCH_LENGTH. Never waits: when the
+// queue is full the patch is dropped and counted, and false is returned.
+bool LiquidCrystal_Queue::push(uint8_t col, uint8_t row, const uint8_t *text,
+                               uint8_t length) {
+  uint8_t head = _head;
+  uint8_t next = (head + 1) & QUEUE_MASK;
+  if (next == _tail) {
+    _dropped = _dropped + 1;
+    return false;
+  }
+
+  LiquidCrystal_Patch &patch = _patches[head];
+  if (length > LCD_PATCH_LENGTH) {
+    length = LCD_PATCH_LENGTH;
+  }
+  patch.col = col;
+  patch.row = row;
+  patch.length = length;
+  memcpy(patch.text, text, length);
+
+  // the patch has to be complete before the consumer can see it
+  __sync_synchronize();
+  _head = next;
+  return true;
+}
+
+uint8_t LiquidCrystal_Queue::pending() const {
+  return (_head - _tail) & QUEUE_MASK;
+}
+
+// How many patches push() had to drop. The count is two bytes, which an AVR
+// reads one at a time, so interrupts are off while it is read; call this
+// from loop(), not from an interrupt handler.
+uint16_t LiquidCrystal_Queue::dropped() const {
+  noInterrupts();
+  uint16_t dropped = _dropped;
+  interrupts();
+  return dropped;
+}
+
+// true if a patch queued after `first` (up to `end`) covers the cell
+bool LiquidCrystal_Queue::overwritten(uint8_t first, uint8_t end, uint8_t row,
+                                      uint8_t col) {
+  for (uint8_t i = (first + 1) & QUEUE_MASK; i != end;
+       i = (i + 1) & QUEUE_MASK) {
+    const LiquidCrystal_Patch &later = _patches[i];
+    if (later.row == row && col >= later.col &&
+        col < later.col + later.length) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Sends up to `batch` queued patches and returns how many were taken. Within
+// the batch only the latest text for each cell goes out: the parts of a
+// patch that a later one overwrites are skipped.
+uint8_t LiquidCrystal_Queue::drain(uint8_t batch) {
+  uint8_t tail = _tail;
+  uint8_t count = (_head - tail) & QUEUE_MASK;
+  if (count > batch) {
+    count = batch;
+  }
+  if (!count) {
+    return 0;
+  }
+  // don't read the patches before we have seen _head move past them
+  __sync_synchronize();
+
+  uint8_t end = (tail + count) & QUEUE_MASK;
+  for (uint8_t i = tail; i != end; i = (i + 1) & QUEUE_MASK) {
+    const LiquidCrystal_Patch &patch = _patches[i];
+    uint8_t c = 0;
+    while (c < patch.length) {
+      if (overwritten(i, end, patch.row, patch.col + c)) {
+        c++;
+        continue;
+      }
+      uint8_t start = c;
+      do {
+        c++;
+      } while (c < patch.length &&
+               !overwritten(i, end, patch.row, patch.col + c));
+      _lcd.setCursor(patch.col + start, patch.row);
+      _lcd.write((const uint8_t *)patch.text + start, c - start);
+    }
+  }
+
+  // the producer may reuse the patches once _tail moves past them
+  __sync_synchronize();
+  _tail = end;
+  return count;
+}
@@ -0,0 +1,66 @@
+#ifndef LiquidCrystal_Queue_h
+#define LiquidCrystal_Queue_h
+
+#include "LiquidCrystal.h"
+
+// number of patch slots; the ring keeps one empty to tell full from empty,
+// so the queue holds one patch fewer
+#ifndef LCD_QUEUE_SIZE
+#define LCD_QUEUE_SIZE 8
+#endif
+static_assert((LCD_QUEUE_SIZE & (LCD_QUEUE_SIZE - 1)) == 0,
+              "LCD_QUEUE_SIZE must be a power of two");
+
+// most characters a single patch carries
+#ifndef LCD_PATCH_LENGTH
+#define LCD_PATCH_LENGTH 16
+#endif
+
+// text to put on the display at (col, row)
+struct LiquidCrystal_Patch {
+  uint8_t col;
+  uint8_t row;
+  uint8_t length;
+  char text[LCD_PATCH_LENGTH];
+};
+
+// A single-producer, single-consumer ring of display patches, so that an
+// interrupt handler can put text on the display without waiting for the
+// bus. push() copies the text and returns straight away; loop() calls
+// drain() to send what has been queued.
+//
+//   LiquidCrystal_Queue queue(lcd);
+//   ISR(...) { queue.push(0, 1, "FAULT"); }
+//   void loop() { queue.drain(); }
+//
+// The producer only writes _head and the consumer only writes _tail, both
+// single bytes, so neither side needs to turn interrupts off. There must be
+// only one producer: two interrupt handlers that can preempt each other
+// need a queue each.
+//
+// drain() takes each byte of a patch for one cell when it merges patches,
+// so on a display that translates UTF-8 (a ROM given to begin()) patches
+// must be plain ASCII.
+class LiquidCrystal_Queue {
+public:
+  LiquidCrystal_Queue(LiquidCrystal_Base &lcd);
+
+  bool push(uint8_t col, uint8_t row, const char *text);
+  bool push(uint8_t col, uint8_t row, const uint8_t *text, uint8_t length);
+
+  uint8_t drain(uint8_t batch = LCD_QUEUE_SIZE);
+
+  uint8_t pending() const;
+  uint16_t dropped() const;
+
+private:
+  bool overwritten(uint8_t first, uint8_t end, uint8_t row, uint8_t col);
+
+  LiquidCrystal_Base &_lcd;
+  LiquidCrystal_Patch _patches[LCD_QUEUE_SIZE];
+  volatile uint8_t _head; // next patch to fill, written by the producer
+  volatile uint8_t _tail; // next patch to send, written by the consumer
+  volatile uint16_t _dropped;
+};
+
+#endif
@@ -0,0 +1,117 @@
+#include "LiquidCrystal.h"
+
+#include <inttypes.h>
+
+#if LCD_ENABLE_RW
+
+// Reading the controller back through the RW pin. Every read leaves our copy
+// of the address counter, and so the place the sketch writes next, alone.
+
+// how many cells verify() reads back at a time
+#define VERIFY_CHUNK 20
+
+// The controller's address counter, or LCD_NOCHAR without an RW pin.
+uint8_t LiquidCrystal_Base::readAddressCounter() {
+  if (_rw_pin == 255) {
+    return LCD_NOCHAR;
+  }
+  if (_skipped) {
+    restoreAddress();
+  }
+  return read(LOW) & 0x7F;
+}
+
+// Reads `size` DDRAM bytes starting at `address`. Returns how many were read,
+// which is 0 without an RW pin.
+size_t LiquidCrystal_Base::readDDRAM(uint8_t address, uint8_t *buffer,
+                                     size_t size) {
+  size = readRam(LCD_SETDDRAMADDR | (address & 0x7F), buffer, size);
+  restoreAddress();
+  return size;
+}
+
+#if LCD_ENABLE_CGRAM
+// Reads `size` CGRAM bytes starting at `address`, which is location * 8 plus
+// the row for a custom character.
+size_t LiquidCrystal_Base::readCGRAM(uint8_t address, uint8_t *buffer,
+                                     size_t size) {
+  size = readRam(LCD_SETCGRAMADDR | (address & 0x3F), buffer, size);
+  restoreAddress();
+  return size;
+}
+#endif
+
+// Compares what the display shows with the shadow and, if `repair` is set,
+// rewrites the cells that differ in as few runs as it can. Meant to run now
+// and then on displays that electrical noise sometimes scrambles, instead of
+// begin() and a full redraw. Returns how many cells differed; 0 without an
+// RW pin or a shadow.
+uint16_t LiquidCrystal_Base::verify(bool repair) {
+  if (_rw_pin == 255 || !_shadow) {
+    return 0;
+  }
+  uint8_t address = _address;
+  uint8_t mode = _displaymode;
+  uint16_t wrong = 0;
+  uint8_t rows = (_numlines < 4) ? _numlines : 4;
+  uint8_t shown[VERIFY_CHUNK];
+  for (uint8_t row = 0; row < rows; row++) {
+    for (uint8_t first = 0; first < _cols; first += VERIFY_CHUNK) {
+      uint8_t count = _cols - first;
+      if (count > VERIFY_CHUNK) {
+        count = VERIFY_CHUNK;
+      }
+      readRam(LCD_SETDDRAMADDR | (_row_offsets[row] + first), shown, count);
+      const uint8_t *expected = _shadow + row * _cols + first;
+
+      uint8_t i = 0;
+      while (i < count) {
+        if (shown[i] == expected[i]) {
+          i++;
+          continue;
+        }
+        if (repair) {
+          beginRun(); // left to right, whatever the sketch uses
+          setAddress(first + i, row);
+          setMode(HIGH);
+        }
+        do {
+          if (repair) {
+            putChar(expected[i]);
+          }
+          wrong++;
+          i++;
+        } while (i < count && shown[i] != expected[i]);
+      }
+    }
+  }
+  endRun(mode);
+  _address = address;
+  restoreAddress();
+  return wrong;
+}
+
+// Reads RAM after the address command `set`, leaving the controller's
+// address counter wherever the reads took it. The controller steps it after
+// a read the same way it does after a write, so reading runs in increment
+// mode whatever the sketch has chosen.
+size_t LiquidCrystal_Base::readRam(uint8_t set, uint8_t *buffer,
+                                   size_t size) {
+  if (_rw_pin == 255) {
+    return 0;
+  }
+  bool decrement = !(_displaymode & LCD_ENTRYLEFT);
+  if (decrement) {
+    command(LCD_ENTRYMODESET | _displaymode | LCD_ENTRYLEFT);
+  }
+  command(set);
+  for (size_t i = 0; i < size; i++) {
+    buffer[i] = read(HIGH);
+  }
+  if (decrement) {
+    command(LCD_ENTRYMODESET | _displaymode);
+  }
+  return size;
+}
+
+#endif
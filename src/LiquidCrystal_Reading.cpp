@@ -0,0 +1,77 @@
+#include "LiquidCrystal_Reading.h"
+
+#include <inttypes.h>
+
+LiquidCrystal_Reading::LiquidCrystal_Reading(LiquidCrystal_Base &lcd,
+                                             uint8_t col, uint8_t row,
+                                             uint8_t width, uint8_t decimals)
+    : _lcd(lcd), _col(col + width - 1), _row(row), _width(width),
+      _decimals(decimals), _deadband(0), _min_interval(0), _max_interval(0),
+      _threshold(0), _hysteresis(0), _watching(false), _above(false),
+      _drawn(false), _shown(0), _drawn_at(0) {}
+
+// A field of a layout.
+LiquidCrystal_Reading::LiquidCrystal_Reading(LiquidCrystal_Base &lcd,
+                                             const LiquidCrystal_Item *item,
+                                             uint8_t decimals)
+    : LiquidCrystal_Reading(lcd, pgm_read_byte(&item->col),
+                            pgm_read_byte(&item->row),
+                            pgm_read_byte(&item->width), decimals) {}
+
+// The field is redrawn no more often than every `minimum` ms, and, if the
+// value has changed at all, at least every `maximum` ms; 0 for no limit.
+void LiquidCrystal_Reading::setInterval(uint16_t minimum, uint16_t maximum) {
+  _min_interval = minimum;
+  _max_interval = maximum;
+}
+
+// Reports LCD_READING_ABOVE when the value rises past `threshold`, and
+// LCD_READING_BELOW when it falls below `threshold - hysteresis` again.
+void LiquidCrystal_Reading::setThreshold(long threshold,
+                                         unsigned long hysteresis) {
+  _threshold = threshold;
+  _hysteresis = hysteresis;
+  _watching = true;
+  _above = false;
+}
+
+// Takes the latest value and redraws the field if it should show it.
+// Returns the events it caused, 0 for none.
+uint8_t LiquidCrystal_Reading::update(long value, unsigned long now) {
+  uint8_t events = 0;
+  if (_watching && !_above && value > _threshold) {
+    _above = true;
+    events |= LCD_READING_ABOVE;
+  } else if (_watching && _above &&
+             value < (long)(_threshold - _hysteresis)) {
+    _above = false;
+    events |= LCD_READING_BELOW;
+  }
+
+  if (_drawn && value == _shown) {
+    return events;
+  }
+  if (!_drawn || events) {
+    draw(value, now);
+    return events | LCD_READING_CHANGED;
+  }
+  unsigned long since = now - _drawn_at;
+  if (since < _min_interval) {
+    return events;
+  }
+  unsigned long distance = (value > _shown)
+                               ? (unsigned long)value - (unsigned long)_shown
+                               : (unsigned long)_shown - (unsigned long)value;
+  if (distance > _deadband || (_max_interval && since >= _max_interval)) {
+    draw(value, now);
+    events |= LCD_READING_CHANGED;
+  }
+  return events;
+}
+
+void LiquidCrystal_Reading::draw(long value, unsigned long now) {
+  _lcd.printRight(_col, _row, value, _width, _decimals);
+  _shown = value;
+  _drawn = true;
+  _drawn_at = now;
+}
@@ -0,0 +1,70 @@
+#ifndef LiquidCrystal_Reading_h
+#define LiquidCrystal_Reading_h
+
+#include "LiquidCrystal.h"
+
+// what update() returns, or'ed together
+#define LCD_READING_CHANGED 0x01 // the field shows a new value
+#define LCD_READING_ABOVE 0x02   // the value rose past the threshold
+#define LCD_READING_BELOW 0x04   // it fell back below threshold - hysteresis
+
+// A number shown in a field of the display that is only redrawn when it
+// means something: when the value moves further than the deadband from
+// what the field shows, no more often than a minimum interval, and at
+// least every maximum interval if it drifted within the deadband. Sensor
+// noise doesn't make the last digit flicker, and a quiet plant sends
+// nothing at all. update() also tells the control logic when the value
+// crosses a threshold, with hysteresis so that it doesn't chatter; a
+// crossing is drawn at once, whatever the deadband and intervals.
+//
+//   LiquidCrystal_Reading temperature(lcd, 5, 0, 5, 1); // tenths
+//
+//   temperature.setDeadband(2);       // 0.2 degrees
+//   temperature.setInterval(250, 5000);
+//   temperature.setThreshold(800, 20); // 80 degrees, clears at 78
+//   ...
+//   if (temperature.update(reading) & LCD_READING_ABOVE) {
+//     fan.on();
+//   }
+//
+// The value is a fixed-point number with `decimals` digits after the
+// point, printed right-aligned in `width` columns with printRight().
+class LiquidCrystal_Reading {
+public:
+  LiquidCrystal_Reading(LiquidCrystal_Base &lcd, uint8_t col, uint8_t row,
+                        uint8_t width, uint8_t decimals = 0);
+  LiquidCrystal_Reading(LiquidCrystal_Base &lcd, const LiquidCrystal_Item *,
+                        uint8_t decimals = 0);
+
+  void setDeadband(unsigned long deadband) { _deadband = deadband; }
+  void setInterval(uint16_t minimum, uint16_t maximum = 0);
+  void setThreshold(long threshold, unsigned long hysteresis);
+
+  uint8_t update(long value) { return update(value, millis()); }
+  uint8_t update(long value, unsigned long now);
+  void redraw() { _drawn = false; }
+
+  long shown() const { return _shown; }
+  bool above() const { return _above; }
+
+private:
+  void draw(long value, unsigned long now);
+
+  LiquidCrystal_Base &_lcd;
+  uint8_t _col; // the last column of the field
+  uint8_t _row;
+  uint8_t _width;
+  uint8_t _decimals;
+  unsigned long _deadband;
+  uint16_t _min_interval; // ms
+  uint16_t _max_interval; // ms, or 0
+  long _threshold;
+  unsigned long _hysteresis;
+  bool _watching; // a threshold is set
+  bool _above;
+  bool _drawn; // the field shows _shown
+  long _shown;
+  unsigned long _drawn_at;
+};
+
+#endif
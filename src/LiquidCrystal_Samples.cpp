@@ -0,0 +1,84 @@
+#include "LiquidCrystal_Samples.h"
+
+#include <inttypes.h>
+
+#define RING_MASK (LCD_SAMPLE_RING - 1)
+
+LiquidCrystal_Samples::LiquidCrystal_Samples()
+    : _head(0), _tail(0), _dropped(0), _active(0) {
+  _windows[0].count = 0;
+  _windows[1].count = 0;
+}
+
+// Records a sample. It always counts towards the current window; it goes in
+// the ring as well unless that is full, in which case it is counted by
+// dropped() instead. A window holds up to 65535 samples; later ones only
+// move its min, max and last time.
+void LiquidCrystal_Samples::add(int16_t value, unsigned long time) {
+  LiquidCrystal_Window &window = _windows[_active];
+  if (!window.count) {
+    window.min = window.max = value;
+    window.sum = 0;
+    window.first = time;
+  } else if (value < window.min) {
+    window.min = value;
+  } else if (value > window.max) {
+    window.max = value;
+  }
+  if (window.count < 0xFFFF) {
+    window.sum += value;
+    window.count++;
+  }
+  window.last = time;
+
+  uint8_t head = _head;
+  uint8_t next = (head + 1) & RING_MASK;
+  if (next == _tail) {
+    _dropped = _dropped + 1;
+    return;
+  }
+  _ring[head].time = time;
+  _ring[head].value = value;
+
+  // the sample has to be complete before the consumer can see it
+  __sync_synchronize();
+  _head = next;
+}
+
+// Closes the current window, starts the next one and returns what the
+// closed one saw. Returns false if no sample came in since the last call.
+bool LiquidCrystal_Samples::window(LiquidCrystal_Window &window) {
+  uint8_t closed = _active;
+  _active = closed ^ 1;
+  // an interrupt from here on adds to the other window
+  __sync_synchronize();
+  window = _windows[closed];
+  _windows[closed].count = 0;
+  return window.count != 0;
+}
+
+// How many samples missed the ring. An interrupt handler may be adding to
+// the count, so it is read with interrupts off: call this from loop().
+uint16_t LiquidCrystal_Samples::dropped() const {
+  noInterrupts();
+  uint16_t dropped = _dropped;
+  interrupts();
+  return dropped;
+}
+
+// Takes the oldest raw sample from the ring. Returns false if it is empty.
+bool LiquidCrystal_Samples::take(LiquidCrystal_Sample &sample) {
+  uint8_t tail = _tail;
+  if (tail == _head) {
+    return false;
+  }
+  // don't read the sample before we have seen _head move past it
+  __sync_synchronize();
+  sample = _ring[tail];
+  _tail = (tail + 1) & RING_MASK;
+  return true;
+}
+
+uint8_t LiquidCrystal_Samples::pending() const {
+  return (_head - _tail) & RING_MASK;
+}
@@ -0,0 +1,73 @@
+#ifndef LiquidCrystal_Samples_h
+#define LiquidCrystal_Samples_h
+
+#include "LiquidCrystal.h"
+
+// slots in a channel's ring of raw samples, which keeps up to one fewer
+#ifndef LCD_SAMPLE_RING
+#define LCD_SAMPLE_RING 16
+#endif
+static_assert((LCD_SAMPLE_RING & (LCD_SAMPLE_RING - 1)) == 0,
+              "LCD_SAMPLE_RING must be a power of two");
+
+// one reading and when it was taken
+struct LiquidCrystal_Sample {
+  unsigned long time; // micros(), or whatever clock the producer passes
+  int16_t value;
+};
+
+// what a channel saw between two calls to window()
+struct LiquidCrystal_Window {
+  int16_t min;
+  int16_t max;
+  int32_t sum;
+  uint16_t count;
+  unsigned long first; // time of the first sample
+  unsigned long last;  // time of the last sample
+  int16_t mean() const { return count ? sum / count : 0; }
+};
+
+// The samples of one sensor channel, taken at full rate by an interrupt
+// handler (or a fast loop) and shown at the display's own pace:
+//
+//   LiquidCrystal_Samples pressure;
+//   ISR(ADC_vect) { pressure.add(ADC); }
+//   void loop() {
+//     LiquidCrystal_Window window;
+//     if (millis() - shown >= 250 && pressure.window(window)) {
+//       shown = millis();
+//       LCD_PRINTF(lcd, "P %4d", window.mean());
+//     }
+//   }
+//
+// add() folds every sample into the current window's min, max and sum, so
+// none is lost however long the display takes, and also keeps it with its
+// time in a ring of LCD_SAMPLE_RING for a consumer that wants the raw
+// samples, like a logger. Nothing is allocated and add() never waits. The
+// producer and the consumer each write their own single-byte indexes, as in
+// LiquidCrystal_Queue, so interrupts stay on; there must be one producer.
+class LiquidCrystal_Samples {
+public:
+  LiquidCrystal_Samples();
+
+  void add(int16_t value) { add(value, micros()); }
+  void add(int16_t value, unsigned long time);
+
+  bool window(LiquidCrystal_Window &window);
+  bool take(LiquidCrystal_Sample &sample);
+
+  uint8_t pending() const;
+  uint16_t dropped() const;
+
+private:
+  LiquidCrystal_Sample _ring[LCD_SAMPLE_RING];
+  volatile uint8_t _head; // next sample to fill, written by the producer
+  volatile uint8_t _tail; // next sample to take, written by the consumer
+  volatile uint16_t _dropped;
+
+  // the producer adds to _windows[_active]; window() swaps them
+  LiquidCrystal_Window _windows[2];
+  volatile uint8_t _active;
+};
+
+#endif
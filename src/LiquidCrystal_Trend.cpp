@@ -0,0 +1,71 @@
+#include "LiquidCrystal_Trend.h"
+
+#include <inttypes.h>
+
+#if LCD_ENABLE_CGRAM
+
+LiquidCrystal_Trend::LiquidCrystal_Trend(LiquidCrystal_Canvas &canvas,
+                                         int16_t low, int16_t high, bool fill)
+    : _canvas(canvas), _low(low), _high(high), _fill(fill) {
+  _col = _row = 0;
+  _x = 0;
+  _last = 0xFF;
+}
+
+// the cell column shown at the left: the one after the newest sample's
+uint8_t LiquidCrystal_Trend::first() const {
+  uint8_t cols = _canvas.width() / 5;
+  uint8_t newest = (_x + _canvas.width() - 1) % _canvas.width() / 5;
+  return (newest + 1) % cols;
+}
+
+// Puts the graph on the display with its top left at col, row.
+void LiquidCrystal_Trend::show(uint8_t col, uint8_t row) {
+  _col = col;
+  _row = row;
+  _canvas.show(_col, _row, first());
+}
+
+// Draws one sample at the right of the graph. Samples outside low..high are
+// drawn at the edge.
+void LiquidCrystal_Trend::add(int16_t value) {
+  uint8_t height = _canvas.height();
+  int32_t level = 0;
+  if (_high > _low) {
+    level = ((int32_t)value - _low) * (height - 1) / ((int32_t)_high - _low);
+  }
+  if (level < 0) {
+    level = 0;
+  } else if (level > height - 1) {
+    level = height - 1;
+  }
+  uint8_t y = height - 1 - level;
+
+  // a line joins the previous sample with a vertical run
+  uint8_t top = y;
+  uint8_t bottom = _fill ? height - 1 : y;
+  if (!_fill && _last != 0xFF) {
+    top = (_last < y) ? _last : y;
+    bottom = (_last > y) ? _last : y;
+  }
+  for (uint8_t row = 0; row < height; row++) {
+    _canvas.setPixel(_x, row, row >= top && row <= bottom);
+  }
+
+  // the sample starts a cell: blank the rest of it, which held the oldest
+  // samples, and move it to the right of the display
+  bool rotate = (_x % 5 == 0);
+  if (rotate) {
+    for (uint8_t x = _x + 1; x < _x + 5; x++) {
+      _canvas.fillColumn(x, 0, height - 1, false);
+    }
+  }
+  _canvas.update();
+  _last = y;
+  _x = (_x + 1) % _canvas.width();
+  if (rotate) {
+    _canvas.show(_col, _row, first());
+  }
+}
+
+#endif
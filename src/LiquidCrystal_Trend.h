@@ -0,0 +1,47 @@
+#ifndef LiquidCrystal_Trend_h
+#define LiquidCrystal_Trend_h
+
+#include "LiquidCrystal_Canvas.h"
+
+#if LCD_ENABLE_CGRAM
+
+// A graph of the last width() samples that scrolls left as samples come in,
+// drawn on a canvas. The canvas is used as a ring: a new sample only changes
+// its own pixel column, so add() sends just the glyph rows that column
+// touches. Every fifth sample the cells on the display rotate by one
+// instead of the bitmap shifting.
+//
+//   LiquidCrystal_Canvas canvas(lcd, 6, 1);
+//   LiquidCrystal_Trend pressure(canvas, 0, 1023);
+//   canvas.begin();
+//   pressure.show(10, 1);
+//   ...
+//   pressure.add(analogRead(A0)); // once a second: a 30 s trend
+//
+// The newest cell, at the right, fills up from its left edge, so the graph
+// shows between width() - 4 and width() samples.
+class LiquidCrystal_Trend {
+public:
+  // samples from low to high span the canvas height; fill draws the area
+  // below the graph, otherwise it is a line
+  LiquidCrystal_Trend(LiquidCrystal_Canvas &canvas, int16_t low, int16_t high,
+                      bool fill = false);
+
+  void show(uint8_t col, uint8_t row);
+  void add(int16_t value);
+
+private:
+  uint8_t first() const;
+
+  LiquidCrystal_Canvas &_canvas;
+  int16_t _low;
+  int16_t _high;
+  bool _fill;
+  uint8_t _col; // where show() put the graph
+  uint8_t _row;
+  uint8_t _x;    // pixel column of the next sample
+  uint8_t _last; // pixel row of the last sample, or 0xFF
+};
+
+#endif
+#endif
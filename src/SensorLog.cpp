@@ -0,0 +1,69 @@
+#include "SensorLog.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+// `block` is the buffer records collect in and `size` is how much of the
+// output each write covers; at least SENSOR_LOG_HEADER + SENSOR_LOG_RECORD,
+// or nothing is logged.
+SensorLog::SensorLog(Print &out, uint8_t *block, uint16_t size)
+    : _out(out), _block(block), _size(size), _used(0), _time(0), _blocks(0) {
+  if (_size < SENSOR_LOG_HEADER + SENSOR_LOG_RECORD) {
+    _size = 0;
+  }
+}
+
+// Records a value for a channel. Returns false for a channel beyond
+// SENSOR_LOG_CHANNELS, or with a block too small for a record. Writes the
+// block out first if the record might not fit.
+bool SensorLog::add(uint8_t channel, int32_t value, unsigned long time) {
+  if (channel >= SENSOR_LOG_CHANNELS || !_size) {
+    return false;
+  }
+  if (_used && _used + SENSOR_LOG_RECORD > _size) {
+    flush();
+  }
+  if (!_used) {
+    start(time);
+  }
+
+  uint32_t change = (uint32_t)value - (uint32_t)_last[channel];
+  _block[_used++] = channel;
+  putVarint((uint32_t)(time - _time));
+  putVarint((change << 1) ^ ((int32_t)change < 0 ? 0xFFFFFFFF : 0));
+  _time = time;
+  _last[channel] = value;
+  return true;
+}
+
+// Pads the block and writes it out, if it holds any records.
+void SensorLog::flush() {
+  if (!_used) {
+    return;
+  }
+  memset(_block + _used, SENSOR_LOG_PAD, _size - _used);
+  _out.write(_block, _size);
+  _used = 0;
+  _blocks++;
+}
+
+void SensorLog::start(unsigned long time) {
+  _block[0] = SENSOR_LOG_SYNC;
+  _block[1] = SENSOR_LOG_BLOCK;
+  _block[2] = _size;
+  _block[3] = _size >> 8;
+  for (uint8_t i = 0; i < 4; i++) {
+    _block[4 + i] = (uint32_t)time >> (8 * i);
+  }
+  _used = SENSOR_LOG_HEADER;
+  _time = time;
+  memset(_last, 0, sizeof(_last));
+}
+
+void SensorLog::putVarint(uint32_t value) {
+  while (value >= 0x80) {
+    _block[_used++] = value | 0x80;
+    value >>= 7;
+  }
+  _block[_used++] = value;
+}
@@ -0,0 +1,69 @@
+#ifndef SensorLog_h
+#define SensorLog_h
+
+#include <Arduino.h>
+#include "Print.h"
+
+// most channels one log records; values are delta coded per channel
+#ifndef SENSOR_LOG_CHANNELS
+#define SENSOR_LOG_CHANNELS 4
+#endif
+
+// The log is a series of blocks, each exactly as long as the writer's
+// buffer and decodable on its own:
+//
+//   SENSOR_LOG_SYNC, 'L', block size (2 bytes), time of its first record
+//   (4 bytes), then records, then SENSOR_LOG_PAD up to the block size
+//
+// A record is the channel, the time since the previous record as a varint,
+// and the value's change since the channel's previous value in the block as
+// a zigzag varint (the first one in a block counts from 0). Multi-byte
+// fields are little-endian; varints are 7 bits a byte, low bits first.
+#define SENSOR_LOG_SYNC 0xA5
+#define SENSOR_LOG_BLOCK 'L'
+#define SENSOR_LOG_HEADER 8
+#define SENSOR_LOG_RECORD 11 // longest record
+#define SENSOR_LOG_PAD 0xFF
+
+// Writes sensor samples to a Print, such as a file on an SD card, in a
+// compact binary form that scripts/sensor_log.py turns back into CSV. A
+// sample of a slowly changing sensor taken at a steady rate takes three or
+// four bytes rather than the dozen or more of a CSV line. Records collect
+// in a block buffer that goes out in one write when it is full, so with a
+// 512-byte buffer every write is one SD sector.
+//
+//   uint8_t block[512];
+//   SensorLog dataLog(file, block, sizeof(block));
+//   ...
+//   dataLog.add(0, analogRead(A0)); // channel 0, timed with micros()
+//   ...
+//   dataLog.flush(); // before closing the file
+//
+// Values are integers; record fixed-point readings scaled, like
+// hundredths of a degree, and give the decoder the scale.
+class SensorLog {
+public:
+  SensorLog(Print &out, uint8_t *block, uint16_t size);
+
+  bool add(uint8_t channel, int32_t value) {
+    return add(channel, value, micros());
+  }
+  bool add(uint8_t channel, int32_t value, unsigned long time);
+  void flush();
+
+  uint32_t blocks() const { return _blocks; }
+
+private:
+  void start(unsigned long time);
+  void putVarint(uint32_t);
+
+  Print &_out;
+  uint8_t *_block;
+  uint16_t _size;
+  uint16_t _used; // bytes of the block filled, 0 before its header
+  unsigned long _time; // time of the last record
+  int32_t _last[SENSOR_LOG_CHANNELS];
+  uint32_t _blocks; // blocks written
+};
+
+#endif
@@ -0,0 +1,118 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_BigNumbers.h"
+#include "LiquidCrystal_CI.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+unittest(begin_sharesCgram) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  byte smiley[8] = {B00000, B10001, B00000, B00000,
+                    B10001, B01110, B00000, B00000};
+  lcd.createChar(0, smiley);
+
+  LiquidCrystal_BigNumbers big(lcd, 16, 2);
+  assertEqual(4, big.positions());
+  assertTrue(big.begin());
+  // 2-row digits take three locations, after the one the sketch used
+  assertEqual(4, lcd.reserveChar());
+
+  big.end();
+  assertEqual(1, lcd.reserveChar());
+}
+
+unittest(begin_failsWhenCgramIsFull) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(20, 4);
+  for (int i = 0; i < 7; i++) {
+    lcd.reserveChar();
+  }
+
+  // 4-row digits need two locations and only one is left
+  LiquidCrystal_BigNumbers big(lcd, 20, 4);
+  assertFalse(big.begin());
+  assertEqual(7, lcd.reserveChar());
+}
+
+unittest(print_fourRows) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(20, 4);
+  LiquidCrystal_BigNumbers big(lcd, 20, 4);
+  assertEqual(5, big.positions());
+  assertTrue(big.begin());
+
+  big.print(8);
+  String full = "\xFF";
+  String top = String((char)0);
+  String bottom = String((char)1);
+  assertEqual(full + top + full, glass.text(0x00, 3));
+  assertEqual(full + bottom + full, glass.text(0x40, 3));
+  assertEqual(full + " " + full, glass.text(0x14, 3));
+  assertEqual(full + bottom + full, glass.text(0x54, 3));
+  assertEqual(B11111, glass.cgram[0 * 8 + 0]);
+  assertEqual(B11111, glass.cgram[1 * 8 + 7]);
+}
+
+unittest(print_onlyChangedCells) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(20, 4);
+  LiquidCrystal_BigNumbers big(lcd, 20, 4);
+  big.begin();
+  big.print(18);
+
+  glass.resetCounts();
+  big.setCursor(0);
+  big.print(19);
+  // the 1 is untouched; 8 -> 9 changes one cell on each of the two lower rows
+  assertEqual(2, glass.writes);
+  assertEqual(2, glass.commands);
+  assertEqual(String("  \xFF"), glass.text(0x14 + 4, 3));
+  assertEqual(String((char)1) + (char)1 + "\xFF", glass.text(0x54 + 4, 3));
+}
+
+unittest(print_twoRowsOnLowerHalf) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(20, 4);
+  LiquidCrystal_BigNumbers big(lcd, 20, 4, 2, 2);
+  big.begin();
+
+  big.print(-1);
+  String bottom = String((char)1);
+  assertEqual(bottom + bottom + bottom, glass.text(0x14, 3));
+  assertEqual(String("   "), glass.text(0x54, 3));
+  assertEqual(String((char)0) + "\xFF ", glass.text(0x14 + 4, 3));
+}
+
+unittest(print_sendsCodesUntranslated) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  String full = "\xFF";
+  String top = String((char)0);
+  String bottom = String((char)1);
+
+  // the ROM a sketch picks for its text doesn't touch the digits' codes
+  const uint8_t roms[] = {LCD_ROM_A00, LCD_ROM_A02};
+  for (int i = 0; i < 2; i++) {
+    lcd.begin(20, 4, LCD_5x8DOTS, roms[i]);
+    LiquidCrystal_BigNumbers big(lcd, 20, 4);
+    assertTrue(big.begin());
+    big.print(8);
+    assertEqual(full + top + full, glass.text(0x00, 3));
+    assertEqual(full + bottom + full, glass.text(0x40, 3));
+    assertEqual(full + " " + full, glass.text(0x14, 3));
+    big.end();
+  }
+}
+
+unittest_main()
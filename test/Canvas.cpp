@@ -0,0 +1,129 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+#include "LiquidCrystal_Canvas.h"
+#include "LiquidCrystal_Trend.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+unittest(canvas_sharesCgram) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  byte smiley[8] = {B00000, B10001, B00000, B00000,
+                    B10001, B01110, B00000, B00000};
+  lcd.createChar(0, smiley);
+
+  LiquidCrystal_Canvas wide(lcd, 8, 1);
+  assertFalse(wide.begin());
+  LiquidCrystal_Canvas square(lcd, 2, 2);
+  assertTrue(square.begin());
+  assertEqual(10, square.width());
+  assertEqual(16, square.height());
+  assertEqual(5, lcd.reserveChar());
+}
+
+unittest(canvas_updateSendsChangedRows) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Canvas canvas(lcd, 8, 1);
+  assertTrue(canvas.begin());
+  lcd.setCursor(3, 1);
+
+  model.resetCounts();
+  canvas.setPixel(0, 0);
+  canvas.setPixel(4, 2);  // the row after next: one run over row 1
+  canvas.setPixel(7, 7);  // cell 1, row 7
+  canvas.setPixel(39, 7); // already set pixels are no change
+  canvas.setPixel(39, 7);
+  canvas.update();
+  assertEqual(B10000, model.cgram[0]);
+  assertEqual(B00001, model.cgram[2]);
+  assertEqual(B00100, model.cgram[8 + 7]);
+  assertEqual(B00001, model.cgram[56 + 7]);
+  assertEqual(3 + 1 + 1, model.writes);
+  assertEqual(3 + 1, model.commands); // an address per run, then the cursor
+  assertEqual(0x43, model.ac);
+
+  // nothing changed, nothing sent
+  model.resetCounts();
+  canvas.update();
+  assertEqual(0, model.writes + model.commands);
+}
+
+unittest(canvas_drawing) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Canvas canvas(lcd, 4, 2);
+  canvas.line(0, 0, 19, 15);
+  assertTrue(canvas.pixel(0, 0));
+  assertTrue(canvas.pixel(19, 15));
+  assertTrue(canvas.pixel(10, 8) || canvas.pixel(10, 9));
+  assertFalse(canvas.pixel(19, 0));
+
+  canvas.fillColumn(19, 0, 15);
+  assertTrue(canvas.pixel(19, 0));
+  canvas.fillColumn(19, 0, 15, false);
+  assertFalse(canvas.pixel(19, 15));
+
+  canvas.setPixel(0, 0);
+  canvas.clear();
+  assertFalse(canvas.pixel(0, 0));
+}
+
+unittest(trend_sendsOneColumnPerSample) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Canvas canvas(lcd, 6, 1);
+  LiquidCrystal_Trend trend(canvas, 0, 70);
+  assertTrue(canvas.begin());
+  trend.show(10, 1);
+  assertEqual(0, model.ddram[0x40 + 10]);
+  assertEqual(5, model.ddram[0x40 + 15]);
+
+  // the first sample starts cell 0, which moves to the right
+  trend.add(0);
+  assertEqual(B10000, model.cgram[7]);
+  assertEqual(1, model.ddram[0x40 + 10]);
+  assertEqual(0, model.ddram[0x40 + 15]);
+
+  // a flat line only touches the bottom glyph row
+  model.resetCounts();
+  trend.add(0);
+  assertEqual(B11000, model.cgram[7]);
+  assertEqual(1, model.writes);
+
+  // a step draws a vertical run from the last sample
+  model.resetCounts();
+  trend.add(70);
+  assertEqual(B00100, model.cgram[0]);
+  assertEqual(B00100, model.cgram[3]);
+  assertEqual(B11100, model.cgram[7]);
+  assertEqual(8, model.writes);
+}
+
+unittest(trend_takesTheWholeInt16Range) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Canvas canvas(lcd, 6, 1);
+  LiquidCrystal_Trend trend(canvas, -30000, 30000);
+  assertTrue(canvas.begin());
+  trend.show(10, 1);
+
+  // a difference of 60000 needs 32 bits, which int is not on AVR
+  trend.add(30000);
+  assertEqual(B10000, model.cgram[0]);
+  trend.add(-30000);
+  assertEqual(B01000, model.cgram[7]);
+}
+
+unittest_main()
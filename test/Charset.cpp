@@ -0,0 +1,110 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+const LiquidCrystal_Glyph glyphs[] PROGMEM = {
+    {0x005C, {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00}}, // backslash
+    {0x00D8, {0x0E, 0x13, 0x15, 0x15, 0x15, 0x19, 0x0E, 0x00}}, // O stroke
+    {0x00E9, {0x02, 0x04, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00}}, // e acute
+};
+
+unittest(raw_passesBytesThrough) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  lcd.write(0xDF);
+  lcd.print("C");
+  assertEqual(String("\xDF"
+                     "C"),
+              glass.text(0x00, 2));
+}
+
+unittest(a00_translatesUtf8) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2, LCD_5x8DOTS, LCD_ROM_A00);
+  glass.resetCounts();
+  lcd.print("25\xC2\xB0"
+            "C \xCE\xA9 \xEF\xBD\xB1");
+  // degree sign, omega and a halfwidth katakana A; one byte each on the bus
+  assertEqual(8, glass.writes);
+  assertEqual(String("25\xDF"
+                     "C \xF4 \xB1"),
+              glass.text(0x00, 8));
+}
+
+unittest(a02_translatesUtf8) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2, LCD_5x8DOTS, LCD_ROM_A02);
+  lcd.print("\xC3\x84\xCE\xA9\xC2\xB5\xD0\x96");
+  assertEqual(String("\xC4\x9A\xB5\x82"), glass.text(0x00, 4));
+}
+
+unittest(translate_reachesCode0xFF) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2, LCD_5x8DOTS, LCD_ROM_A00);
+  lcd.print("\xE2\x96\x88"); // full block
+  assertEqual(0xFF, glass.ddram[0x00]);
+
+  lcd.begin(16, 2, LCD_5x8DOTS, LCD_ROM_A02);
+  lcd.print("\xC3\xBF"); // y umlaut
+  assertEqual(0xFF, glass.ddram[0x00]);
+}
+
+unittest(writeRaw_isNeverTranslated) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2, LCD_5x8DOTS, LCD_ROM_A00);
+  lcd.writeRaw(0xFF);
+  lcd.writeRaw(0xC3);
+  lcd.writeRaw('\\');
+  lcd.writeRaw(0x01);
+  assertEqual(String("\xFF\xC3\\\x01"), glass.text(0x00, 4));
+}
+
+unittest(translate_unmappedAndMalformed) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2, LCD_5x8DOTS, LCD_ROM_A02);
+  // an emoji, a stray continuation byte and a truncated sequence
+  lcd.print("\xF0\x9F\x98\x80\x80\xC3Z");
+  assertEqual(String("??Z"), glass.text(0x00, 3));
+}
+
+unittest(translate_loadsGlyphs) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2, LCD_5x8DOTS, LCD_ROM_A00);
+  byte smiley[8] = {B00000, B10001, B00000, B00000,
+                    B10001, B01110, B00000, B00000};
+  lcd.createChar(0, smiley);
+  lcd.setGlyphs(glyphs, 3, 1);
+
+  lcd.setCursor(0, 1);
+  lcd.print("a\\b\\");
+  // the backslash went to the first free location and the text carried on
+  // in DDRAM after it was loaded
+  assertEqual(String("a\x01"
+                     "b\x01"),
+              glass.text(0x40, 4));
+  assertEqual(0x10, glass.cgram[1 * 8 + 1]);
+
+  // with one location allowed, the next glyph replaces it
+  lcd.print("\xC3\xA9");
+  assertEqual(1, glass.ddram[0x44]);
+  assertEqual(0x0E, glass.cgram[1 * 8 + 2]);
+  assertEqual(B10001, glass.cgram[0 * 8 + 1]);
+}
+
+unittest_main()
@@ -1,5 +1,10 @@
 #include <bitset>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "Arduino.h"
@@ -19,13 +24,54 @@ const byte d5 = 15;
 const byte d6 = 16;
 const byte d7 = 17;
 
+// Records rs, rw and d7-d0 at every rising edge of the enable pin, and the
+// simulated time it came at, counted from when the collector was made.
 class BitCollector : public DataStreamObserver {
 private:
   bool fourBitMode;
   bool showData;
   vector<int> pinLog;
+  vector<unsigned long> times;
   GodmodeState *state;
 
+  // the trace as written to a golden file
+  std::string trace(const char *name) {
+    std::ostringstream text;
+    text << "# bus trace: " << name << "\n";
+    text << "# " << (fourBitMode ? 4 : 8) << "-bit, " << pinLog.size()
+         << " pulses, " << state->micros << " us\n";
+    text << "#       us rs rw data\n";
+    for (size_t i = 0; i < pinLog.size(); ++i) {
+      char line[32];
+      snprintf(line, sizeof(line), "%10lu  %d  %d  %02X\n", times[i],
+               (pinLog[i] >> 9) & 1, (pinLog[i] >> 8) & 1, pinLog[i] & 0xFF);
+      text << line;
+    }
+    return text.str();
+  }
+
+  // the "4-bit, 46 pulses, 4692 us" line of a trace
+  static std::string summary(const std::string &trace) {
+    size_t start = trace.find("\n# ");
+    if (start == std::string::npos) {
+      return "(missing)";
+    }
+    start += 3;
+    return trace.substr(start, trace.find('\n', start) - start);
+  }
+
+  static std::string goldenPath(const char *name) {
+    const char *dir = getenv("LCD_GOLDEN_DIR");
+    std::string path;
+    if (dir) {
+      path = std::string(dir) + "/";
+    } else {
+      std::string file = __FILE__;
+      path = file.substr(0, file.find_last_of("/\\") + 1) + "golden/";
+    }
+    return path + name + ".trace";
+  }
+
 public:
   BitCollector(bool showData = false, bool fourBitMode = true)
       : DataStreamObserver(false, false) {
@@ -52,6 +98,7 @@ public:
       value = (value << 1) + state->digitalPin[d1];
       value = (value << 1) + state->digitalPin[d0];
       pinLog.push_back(value);
+      times.push_back(state->micros);
       if (showData) {
         std::cout.width(5);
         std::cout << std::right << value << " : " << ((value >> 9) & 1) << "  "
@@ -83,6 +130,28 @@ public:
     return true;
   }
 
+  // Compares the trace with test/golden/<name>.trace, or writes it there
+  // when LCD_UPDATE_GOLDEN is set. On a difference it prints how the number
+  // of enable pulses and the bus time changed; scripts/bus_trace.py shows
+  // the details.
+  bool matchesGolden(const char *name) {
+    std::string path = goldenPath(name);
+    std::string now = trace(name);
+    if (getenv("LCD_UPDATE_GOLDEN")) {
+      std::ofstream(path.c_str()) << now;
+      return true;
+    }
+    std::ifstream file(path.c_str());
+    std::stringstream golden;
+    golden << file.rdbuf();
+    if (golden.str() == now) {
+      return true;
+    }
+    std::cout << "trace " << name << " changed: " << summary(golden.str())
+              << " -> " << summary(now) << std::endl;
+    return false;
+  }
+
   virtual String observerName() const { return "BitCollector"; }
 };
 
@@ -547,3 +616,86 @@ unittest(write) {
   lcd.write('n');
   assertTrue(pinValues.isEqualTo(expected));
 }
+
+int idleCalls = 0;
+void idleHook() {
+  ++idleCalls;
+  delayMicroseconds(300); // stands in for a sensor read
+}
+
+unittest(idle_hook) {
+  GodmodeState *state = GODMODE();
+  LiquidCrystal_Test lcd(rs, enable, d4, d5, d6, d7);
+  lcd.setIdleHook(idleHook);
+  state->reset();
+  idleCalls = 0;
+  lcd.begin(16, 2);
+  // called through the 50 ms power-on wait, both 4.1 ms waits and clear()
+  assertMore(idleCalls, (50000 + 4500 + 4500 + 2000) / 300 - 4);
+  assertMore(state->micros, 50000 + 4500 + 4500 + 2000);
+
+  // home() waits 2 ms, which a higher threshold leaves to delayMicroseconds()
+  lcd.setIdleHook(idleHook, 5000);
+  idleCalls = 0;
+  lcd.home();
+  assertEqual(0, idleCalls);
+
+  lcd.setIdleHook(NULL);
+  lcd.clear();
+  assertEqual(0, idleCalls);
+}
+
+// Whole workloads checked against the traces in test/golden, so that any
+// change to what goes on the bus, or how long it takes, shows up. After a
+// deliberate change, run the tests with LCD_UPDATE_GOLDEN=1 and commit the
+// new traces; scripts/bus_trace.py diff compares two sets of them.
+
+unittest(golden_begin) {
+  LiquidCrystal_Test lcd(rs, enable, d4, d5, d6, d7);
+  BitCollector pinValues(false);
+  lcd.begin(16, 2);
+  assertTrue(pinValues.matchesGolden("begin"));
+}
+
+unittest(golden_begin8bit) {
+  LiquidCrystal_Test lcd(rs, enable, d0, d1, d2, d3, d4, d5, d6, d7);
+  BitCollector pinValues(false, false);
+  lcd.begin(20, 4);
+  assertTrue(pinValues.matchesGolden("begin8bit"));
+}
+
+unittest(golden_print) {
+  LiquidCrystal_Test lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  BitCollector pinValues(false);
+  lcd.print("Hello, World!");
+  lcd.setCursor(0, 1);
+  lcd.print(12345);
+  lcd.print(F(" rpm"));
+  assertTrue(pinValues.matchesGolden("print"));
+}
+
+unittest(golden_createChar) {
+  byte smiley[8] = {B00000, B10001, B00000, B00000,
+                    B10001, B01110, B00000, B00000};
+  LiquidCrystal_Test lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  BitCollector pinValues(false);
+  lcd.createChar(0, smiley);
+  lcd.setCursor(0, 0);
+  lcd.write(byte(0));
+  assertTrue(pinValues.matchesGolden("createChar"));
+}
+
+unittest(golden_drawFrame) {
+  LiquidCrystal_Test lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2], frame[16 * 2];
+  lcd.attachShadow(shadow);
+  memcpy(frame, "Temp    21.5 C  Fan on          ", sizeof(frame));
+  lcd.drawFrame(frame);
+  BitCollector pinValues(false);
+  memcpy(frame, "Temp    22.0 C  Fan off         ", sizeof(frame));
+  lcd.drawFrame(frame);
+  assertTrue(pinValues.matchesGolden("drawFrame"));
+}
@@ -0,0 +1,86 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+#include "LiquidCrystal_Console.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+unittest(console_rowsFollowEachOther) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(20, 4);
+  uint8_t log[20 * 4];
+  LiquidCrystal_Console console(lcd, log, 20, 4);
+  console.clear();
+
+  console.println("one");
+  console.print("two\r2");
+  console.print("\nthree\b\bEE");
+  assertEqual("one                 ", model.text(0x00, 20));
+  assertEqual("2wo                 ", model.text(0x40, 20));
+  assertEqual("thrEE               ", model.text(0x14, 20));
+}
+
+unittest(console_wrapsFullRows) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t log[16 * 2];
+  LiquidCrystal_Console console(lcd, log, 16, 2);
+  console.clear();
+
+  // a row that fills up exactly doesn't leave a blank one after println()
+  console.println("0123456789abcdef");
+  console.print("0123456789abcdefXY");
+  assertEqual("0123456789abcdef", model.text(0x00, 16));
+  assertEqual("XY              ", model.text(0x40, 16));
+}
+
+unittest(console_scrollRewritesOnlyChanges) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(20, 4);
+  uint8_t shadow[20 * 4];
+  lcd.attachShadow(shadow);
+  uint8_t log[20 * 4];
+  LiquidCrystal_Console console(lcd, log, 20, 4);
+  console.clear();
+
+  console.println("12:00:01 E12 fan");
+  console.println("12:00:02 E12 fan");
+  console.println("12:00:03 E12 fan");
+  console.print("12:00:04 E12 fan");
+
+  model.resetCounts();
+  console.println();
+  assertEqual("12:00:02 E12 fan    ", model.text(0x00, 20));
+  assertEqual("12:00:03 E12 fan    ", model.text(0x40, 20));
+  assertEqual("12:00:04 E12 fan    ", model.text(0x14, 20));
+  assertEqual("                    ", model.text(0x54, 20));
+  assertEqual(3 + 16, model.writes); // a digit on each row, and the blanking
+
+  console.print("12:00:05 E12 fan");
+  assertEqual("12:00:05 E12 fan    ", model.text(0x54, 20));
+}
+
+unittest(console_refusesADisplayOfAnotherSize) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t log[20 * 4];
+  LiquidCrystal_Console console(lcd, log, 20, 4);
+
+  model.resetCounts();
+  assertFalse(console.clear());
+  assertEqual(0, console.print("one\ntwo\nthree\nfour\nfive"));
+  assertEqual(0, model.commands + model.writes);
+}
+
+unittest_main()
@@ -0,0 +1,110 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+// counts how often the driver touches the RS pin
+class RsCounter : public DataStreamObserver {
+public:
+  RsCounter() : DataStreamObserver(false, false), count(0) {
+    GODMODE()->digitalPin[rs].addObserver("rs", this);
+  }
+  ~RsCounter() { GODMODE()->digitalPin[rs].removeObserver("rs"); }
+  virtual void onBit(bool aBit) { ++count; }
+  virtual String observerName() const { return "RsCounter"; }
+  int count;
+};
+
+const char screen[] PROGMEM = "Temp:      C\n"
+                              "Pressure:   kPa";
+const LiquidCrystal_Field tempField PROGMEM = {6, 0, 4};
+
+unittest(print_flashStringIsOneRun) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  RsCounter rsWrites;
+  assertEqual(5, lcd.print(F("Hello")));
+  assertEqual(1, rsWrites.count);
+  assertEqual(String("Hello"), glass.text(0x00, 5));
+}
+
+unittest(write_bufferIsOneRun) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  RsCounter rsWrites;
+  lcd.print("Hello");
+  assertEqual(1, rsWrites.count);
+  assertEqual(String("Hello"), glass.text(0x00, 5));
+}
+
+unittest(drawScreen_replacesEveryRow) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 4);
+  lcd.print("old text everywhere");
+  lcd.setCursor(0, 3);
+  lcd.print("old");
+
+  RsCounter rsWrites;
+  glass.resetCounts();
+  lcd.drawScreen((const __FlashStringHelper *)screen);
+  // an address and a run of data per row
+  assertEqual(4, glass.commands);
+  assertEqual(64, glass.writes);
+  assertEqual(8, rsWrites.count);
+  assertEqual(String("Temp:      C    "), glass.text(0x00, 16));
+  assertEqual(String("Pressure:   kPa "), glass.text(0x40, 16));
+  assertEqual(String("                "), glass.text(0x10, 16));
+  assertEqual(String("                "), glass.text(0x50, 16));
+
+  lcd.setCursor(&tempField);
+  lcd.print(F("21.5"));
+  assertEqual(String("Temp: 21.5 C    "), glass.text(0x00, 16));
+}
+
+unittest(drawScreen_drawsLeftToRightWhateverTheEntryMode) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  lcd.rightToLeft();
+
+  lcd.drawScreen((const __FlashStringHelper *)screen);
+  assertEqual(String("Temp:      C    "), glass.text(0x00, 16));
+  assertEqual(String("Pressure:   kPa "), glass.text(0x40, 16));
+  assertFalse(glass.increment);
+}
+
+unittest(drawScreen_cutsLongRows) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(8, 2);
+  lcd.drawScreen(F("0123456789\nab"));
+  assertEqual(String("01234567"), glass.text(0x00, 8));
+  assertEqual(String(" "), glass.text(0x08, 1));
+  assertEqual(String("ab      "), glass.text(0x40, 8));
+}
+
+unittest(drawScreen_mock) {
+  LiquidCrystal lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  lcd.drawScreen((const __FlashStringHelper *)screen);
+  std::vector<String> lines = lcd.getLines();
+  assertEqual("Temp:      C    ", lines.at(0));
+  assertEqual("Pressure:   kPa ", lines.at(1));
+
+  lcd.setCursor(&tempField);
+  assertEqual(6, lcd.getCursorCol());
+  assertEqual(0, lcd.getCursorRow());
+}
+
+unittest_main()
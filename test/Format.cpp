@@ -0,0 +1,103 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+#include "LiquidCrystal_Format.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+// the format is taken apart by the compiler
+static_assert(lcdFormatPrefix("T %5.1f C") == 2, "prefix");
+static_assert(lcdFormatWidth("T %5.1f C") == 5, "width");
+static_assert(lcdFormatPrecision("T %5.1f C") == 1, "precision");
+static_assert(lcdFormatType("T %5.1f C") == 'f', "type");
+static_assert(lcdFormatSuffix("T %5.1f C") == 2, "suffix");
+static_assert(lcdFormatSuffix("%3d%%") == 1, "%% is one character");
+static_assert(lcdFormatSuffixAt("T %-05.1lf C") == 10, "suffix start");
+static_assert(lcdFormatFlags("%-04X") ==
+                  (LCD_FORMAT_LEFT | LCD_FORMAT_ZERO | LCD_FORMAT_UPPER),
+              "flags");
+static_assert(lcdFormatError("%5d") == 0, "good format");
+static_assert(lcdFormatError("no conversion") == 1, "no conversion");
+static_assert(lcdFormatError("%5s") == 2, "unsupported type");
+static_assert(lcdFormatError("%d") == 3, "no width");
+static_assert(lcdFormatError("%5d %5d") == 5, "two conversions");
+
+// collects what is printed, for the Print overload
+class Collect : public Print {
+public:
+  Collect() : length(0) {}
+  size_t write(uint8_t value) {
+    text[length++] = value;
+    text[length] = 0;
+    return 1;
+  }
+  char text[32];
+  uint8_t length;
+};
+
+unittest(format_fixedWidthFields) {
+  Collect out;
+  LCD_PRINTF(out, "[%5.1f]", 21.46);
+  LCD_PRINTF(out, "[%5.1f]", -0.04); // no "-0.0"
+  LCD_PRINTF(out, "[%5.2f]", -0.5);
+  assertEqual("[ 21.5][  0.0][-0.50]", String(out.text));
+
+  out.length = 0;
+  LCD_PRINTF(out, "[%-4d]", 42);
+  LCD_PRINTF(out, "[%04d]", -7);
+  LCD_PRINTF(out, "[%+3d]", 5);
+  LCD_PRINTF(out, "[%3u%%]", 100u);
+  assertEqual("[42  ][-007][ +5][100%]", String(out.text));
+
+  out.length = 0;
+  LCD_PRINTF(out, "%4x ", 0xBEEF);
+  LCD_PRINTF(out, "%02X ", (uint8_t)0xA5);
+  LCD_PRINTF(out, "%4x", (int8_t)-1); // the bits of its own type
+  assertEqual("beef A5   ff", String(out.text));
+}
+
+unittest(format_overflowShowsHashes) {
+  Collect out;
+  LCD_PRINTF(out, "<%3d>", 1234);
+  LCD_PRINTF(out, "<%4.1f>", -12.5);
+  assertEqual("<###><####>", String(out.text));
+}
+
+unittest(format_skipsWhatTheDisplayShows) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  lcd.attachShadow(shadow);
+
+  lcd.setCursor(0, 1);
+  LCD_PRINTF(lcd, "Temp %5.1f C", 21.5);
+  assertEqual("Temp  21.5 C    ", model.text(0x40, 16));
+
+  // the same value again sends nothing but the address
+  model.resetCounts();
+  lcd.setCursor(0, 1);
+  LCD_PRINTF(lcd, "Temp %5.1f C", 21.5);
+  assertEqual(0, model.writes);
+  assertEqual(1, model.commands);
+
+  // a shorter value clears what the longer one left
+  model.resetCounts();
+  lcd.setCursor(0, 1);
+  LCD_PRINTF(lcd, "Temp %5.1f C", 9.0);
+  assertEqual("Temp   9.0 C    ", model.text(0x40, 16));
+  assertEqual(3, model.writes); // ' ', '9' and '0'
+
+  // text printed afterwards lands after the field
+  lcd.print("!");
+  assertEqual("Temp   9.0 C!   ", model.text(0x40, 16));
+}
+
+unittest_main()
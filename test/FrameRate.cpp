@@ -0,0 +1,214 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+unittest(refresh_sendsOnlyTheFinalState) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  uint8_t back[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.attachBackBuffer(back);
+  lcd.print("Count:");
+
+  model.resetCounts();
+  for (int i = 0; i <= 250; i++) {
+    lcd.setCursor(7, 0);
+    lcd.print(i);
+  }
+  assertEqual(0, model.writes + model.commands);
+  assertEqual("                ", model.text(0x00, 16));
+
+  assertTrue(lcd.refresh());
+  assertEqual("Count: 250      ", model.text(0x00, 16));
+  assertEqual(6 + 1 + 3, model.writes); // one run over the blank between
+  assertEqual(1 + 1, model.commands);   // its address, the cursor's
+
+  // the cursor is where the sketch left it
+  assertEqual(0x0A, model.ac);
+
+  // nothing changed, nothing sent
+  model.resetCounts();
+  assertTrue(lcd.refresh());
+  assertEqual(0, model.writes);
+}
+
+unittest(refresh_keepsToTheFrameRate) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  uint8_t back[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.attachBackBuffer(back);
+  lcd.setFrameRate(10);
+  delay(100);
+  assertTrue(lcd.refresh());
+
+  lcd.print("1");
+  assertFalse(lcd.refresh());
+  assertEqual(' ', model.ddram[0]);
+
+  delay(100);
+  assertTrue(lcd.refresh());
+  assertEqual('1', model.ddram[0]);
+}
+
+unittest(refresh_spreadsABigRedrawOverSeveralCalls) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  uint8_t back[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.attachBackBuffer(back);
+  lcd.setFrameRate(0, 1000); // each character takes about 200 us
+  lcd.print("0123456789abcdef");
+  lcd.setCursor(0, 1);
+  lcd.print("ghijklmnopqrstuv");
+  lcd.clear();
+  lcd.print("A  B  C  D  E  F");
+  lcd.setCursor(0, 1);
+  lcd.print("G  H  I  J  K  L");
+
+  int calls = 1;
+  while (!lcd.refresh()) {
+    calls++;
+  }
+  assertMore(calls, 3);
+  assertEqual("A  B  C  D  E  F", model.text(0x00, 16));
+  assertEqual("G  H  I  J  K  L", model.text(0x40, 16));
+}
+
+unittest(refresh_sendsUrgentRegionsBeforeTheFrameIsDue) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  uint8_t back[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.attachBackBuffer(back);
+  lcd.setFrameRate(10);
+  assertTrue(lcd.setUrgent(0, 1, 5));
+  delay(100);
+  assertTrue(lcd.refresh());
+
+  lcd.print("Count: 1");
+  lcd.setCursor(0, 1);
+  lcd.print("ALARM");
+  model.resetCounts();
+  assertFalse(lcd.refresh());
+  assertEqual("ALARM", model.text(0x40, 5));
+  assertEqual(' ', model.ddram[0]); // the rest waits for the frame
+  assertEqual(5, model.writes);
+  assertEqual(1 + 1, model.commands); // its address, the cursor's
+
+  delay(100);
+  assertTrue(lcd.refresh());
+  assertEqual("Count: 1", model.text(0x00, 8));
+}
+
+unittest(refresh_interruptsARedrawForUrgentRegions) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  uint8_t back[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.attachBackBuffer(back);
+  lcd.setFrameRate(0, 1000); // each character takes about 200 us
+  assertTrue(lcd.setUrgent(11, 1, 5));
+  lcd.print("0123456789abcdef");
+  lcd.setCursor(0, 1);
+  lcd.print("ghijklmnopq");
+
+  // the first row is one run, but it stops inside it
+  assertFalse(lcd.refresh());
+  assertEqual('0', model.ddram[0x00]);
+  assertEqual(' ', model.ddram[0x0F]);
+
+  // the alarm goes out first, then the redraw goes on where it stopped
+  lcd.setCursor(11, 1);
+  lcd.print("ALARM");
+  model.resetCounts();
+  lcd.refresh();
+  assertEqual("ALARM", model.text(0x4B, 5));
+  while (!lcd.refresh()) {
+  }
+  assertEqual("0123456789abcdef", model.text(0x00, 16));
+  assertEqual("ghijklmnopqALARM", model.text(0x40, 16));
+}
+
+unittest(refresh_keepsToTheBudgetInsideAChainedRun) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(20, 4);
+  uint8_t shadow[20 * 4];
+  uint8_t back[20 * 4];
+  lcd.attachShadow(shadow);
+  lcd.attachBackBuffer(back);
+  lcd.setFrameRate(0, 500); // each character takes about 200 us
+  for (int i = 0; i < 20 * 4; i++) {
+    lcd.write('a' + i % 26);
+  }
+
+  // the four rows are two runs of 40 cells, but no call sends one whole
+  int calls = 0;
+  int most = 0;
+  bool done;
+  do {
+    model.resetCounts();
+    done = lcd.refresh();
+    calls++;
+    most = (model.writes > most) ? model.writes : most;
+  } while (!done && calls < 100);
+  assertMore(calls, 10);
+  assertLess(most, 5);
+  assertEqual("abcdefghijklmnopqrst", model.text(0x00, 20));
+  assertEqual("uvwxyzabcdefghijklmn", model.text(0x14, 20));
+  assertEqual("opqrstuvwxyzabcdefgh", model.text(0x40, 20));
+  assertEqual("ijklmnopqrstuvwxyzab", model.text(0x54, 20));
+}
+
+unittest(attachBackBuffer_detachingPutsTheCursorBack) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  uint8_t back[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.attachBackBuffer(back);
+  lcd.print("abc");
+  assertTrue(lcd.refresh());
+  lcd.setCursor(0, 1);
+  lcd.attachBackBuffer(NULL);
+
+  lcd.print("XY");
+  assertEqual("abc             ", model.text(0x00, 16));
+  assertEqual("XY              ", model.text(0x40, 16));
+}
+
+unittest(setUrgent_refusesRegionsOffTheDisplay) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  assertFalse(lcd.setUrgent(16, 0, 1));
+  assertFalse(lcd.setUrgent(0, 2, 1));
+  for (int i = 0; i < LCD_URGENT_REGIONS; i++) {
+    assertTrue(lcd.setUrgent(0, 0, 1));
+  }
+  assertFalse(lcd.setUrgent(0, 0, 1));
+  lcd.clearUrgent();
+  assertTrue(lcd.setUrgent(0, 0, 1));
+}
+
+unittest_main()
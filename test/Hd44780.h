@@ -0,0 +1,201 @@
+#pragma once
+// A model of the controller side of the bus for tests that care about what
+// ends up on the display rather than the exact pin sequence. It watches the
+// enable pin like BitCollector does and applies every byte the driver sends
+// to its own DDRAM, CGRAM and address counter. When the driver reads with RW
+// high, it puts the busy flag, address counter or RAM contents on the data
+// pins.
+
+#include <string.h>
+
+#include "Arduino.h"
+#include "ci/ObservableDataStream.h"
+
+class Hd44780 : public DataStreamObserver {
+public:
+  // 4-bit wiring
+  Hd44780(byte rs, byte rw, byte enable, byte d4, byte d5, byte d6, byte d7)
+      : DataStreamObserver(false, false) {
+    byte data[8] = {0, 0, 0, 0, d4, d5, d6, d7};
+    init(rs, rw, enable, data, 4);
+  }
+
+  // 8-bit wiring
+  Hd44780(byte rs, byte rw, byte enable, byte d0, byte d1, byte d2, byte d3,
+          byte d4, byte d5, byte d6, byte d7)
+      : DataStreamObserver(false, false) {
+    byte data[8] = {d0, d1, d2, d3, d4, d5, d6, d7};
+    init(rs, rw, enable, data, 8);
+  }
+
+  ~Hd44780() { state->digitalPin[_enable].removeObserver("hd44780"); }
+
+  // the text of `cols` DDRAM cells starting at `address`
+  String text(uint8_t address, uint8_t cols) {
+    String result;
+    for (uint8_t i = 0; i < cols; i++) {
+      result += (char)ddram[(address + i) & 0x7F];
+    }
+    return result;
+  }
+
+  void resetCounts() { commands = writes = 0; }
+
+  virtual void onBit(bool aBit) {
+    if (!aBit) {
+      return;
+    }
+    if (state->digitalPin[_rw]) {
+      read();
+      return;
+    }
+    uint8_t value = 0;
+    for (int i = 0; i < 8; i++) {
+      if (i >= 8 - _wires && state->digitalPin[_data[i]]) {
+        value |= 1 << i;
+      }
+    }
+    bool rsHigh = state->digitalPin[_rs];
+
+    if (eightBit) {
+      apply(rsHigh, value);
+    } else if (!_haveHigh) {
+      _high = value & 0xF0;
+      _haveHigh = true;
+    } else {
+      _haveHigh = false;
+      apply(rsHigh, _high | (value >> 4));
+    }
+  }
+
+  virtual String observerName() const { return "Hd44780"; }
+
+  uint8_t ddram[128];
+  uint8_t cgram[64];
+  uint8_t ac;
+  bool cgramMode;
+  bool eightBit;
+  bool twoLine;
+  bool increment;
+  uint8_t displayControl;
+  int commands; // command bytes seen since the last resetCounts()
+  int writes;   // data bytes seen since the last resetCounts()
+  int busyPolls;     // status reads that find it busy after a byte
+  int busyPollsSlow; // the same after clear and home
+
+private:
+  void init(byte rs, byte rw, byte enable, const byte *data, int wires) {
+    _rs = rs;
+    _rw = rw;
+    _enable = enable;
+    memcpy(_data, data, sizeof(_data));
+    _wires = wires;
+    _haveHigh = false;
+    memset(ddram, ' ', sizeof(ddram));
+    memset(cgram, 0, sizeof(cgram));
+    ac = 0;
+    cgramMode = false;
+    eightBit = true; // the controller powers up in 8-bit mode
+    twoLine = false;
+    increment = true;
+    displayControl = 0;
+    commands = writes = 0;
+    busyPolls = busyPollsSlow = 0;
+    _busy = 0;
+    _haveReadHigh = false;
+    state = GODMODE();
+    state->digitalPin[_enable].addObserver("hd44780", this);
+  }
+
+  void step(bool forward) {
+    if (cgramMode) {
+      ac = (ac + (forward ? 1 : -1)) & 0x3F;
+    } else if (!twoLine) {
+      ac = forward ? (ac >= 0x4F ? 0x00 : ac + 1) : (ac ? ac - 1 : 0x4F);
+    } else if (forward) {
+      ac = (ac == 0x27) ? 0x40 : (ac >= 0x67 ? 0x00 : ac + 1);
+    } else {
+      ac = (ac == 0x40) ? 0x27 : (ac ? ac - 1 : 0x67);
+    }
+  }
+
+  // drive the data pins for one enable pulse of a read
+  void read() {
+    bool rsHigh = state->digitalPin[_rs];
+    if (!eightBit && _haveReadHigh) {
+      _haveReadHigh = false;
+      drive(_read << 4);
+      return;
+    }
+    if (rsHigh) {
+      _read = cgramMode ? cgram[ac & 0x3F] : ddram[ac & 0x7F];
+      step(increment);
+    } else {
+      _read = ac;
+      if (_busy) {
+        --_busy;
+        _read |= 0x80;
+      }
+    }
+    _haveReadHigh = !eightBit;
+    drive(_read);
+  }
+
+  void drive(uint8_t value) {
+    for (int i = 8 - _wires; i < 8; i++) {
+      state->digitalPin[_data[i]] = (value >> i) & 1;
+    }
+  }
+
+  void apply(bool rsHigh, uint8_t value) {
+    _busy = (!rsHigh && value < 0x04) ? busyPollsSlow : busyPolls;
+    if (rsHigh) {
+      ++writes;
+      if (cgramMode) {
+        cgram[ac & 0x3F] = value;
+      } else {
+        ddram[ac & 0x7F] = value;
+      }
+      step(increment);
+      return;
+    }
+
+    ++commands;
+    if (value & 0x80) {
+      cgramMode = false;
+      ac = value & 0x7F;
+    } else if (value & 0x40) {
+      cgramMode = true;
+      ac = value & 0x3F;
+    } else if (value & 0x20) {
+      eightBit = value & 0x10;
+      twoLine = value & 0x08;
+    } else if (value & 0x10) {
+      if (!(value & 0x08)) { // cursor move
+        step(value & 0x04);
+      }
+    } else if (value & 0x08) {
+      displayControl = value & 0x07;
+    } else if (value & 0x04) {
+      increment = value & 0x02;
+    } else if (value & 0x02) {
+      ac = 0;
+      cgramMode = false;
+    } else if (value & 0x01) {
+      memset(ddram, ' ', sizeof(ddram));
+      ac = 0;
+      cgramMode = false;
+      increment = true;
+    }
+  }
+
+  GodmodeState *state;
+  byte _rs, _rw, _enable;
+  byte _data[8];
+  int _wires;
+  bool _haveHigh;
+  uint8_t _high;
+  int _busy; // status reads left that report busy
+  bool _haveReadHigh;
+  uint8_t _read;
+};
@@ -0,0 +1,89 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+constexpr LiquidCrystal_Geometry panel = {20, 4};
+constexpr char tempLabel[] PROGMEM = "Temp";
+constexpr char unitLabel[] PROGMEM = "C";
+constexpr char faultLabel[] PROGMEM = "Fault:";
+
+LCD_LAYOUT(status, panel,
+           lcdText(panel, 0, 0, tempLabel),
+           lcdField(panel, 4, 0, 6),
+           lcdText(panel, 10, 0, unitLabel),
+           lcdText(panel, 0, 3, faultLabel),
+           lcdField(panel, 7, 3, 13));
+
+// the addresses are there at compile time
+static_assert(status[2].address == 0x0A, "row 0");
+static_assert(status[3].address == 0x54, "row 3 follows row 1");
+static_assert(status[3].width == 6, "text length");
+
+// and so is the validation LCD_LAYOUT fails the build with
+constexpr LiquidCrystal_Item overlapping[] = {
+    lcdText(panel, 0, 0, tempLabel),
+    lcdField(panel, 3, 0, 2),
+};
+static_assert(!lcdLayoutFits(overlapping, panel), "overlap");
+constexpr LiquidCrystal_Item offTheEdge[] = {lcdField(panel, 15, 1, 6)};
+static_assert(!lcdLayoutFits(offTheEdge, panel), "past the last column");
+constexpr LiquidCrystal_Item belowTheBottom[] = {lcdField(panel, 0, 4, 1)};
+static_assert(!lcdLayoutFits(belowTheBottom, panel), "past the last row");
+
+unittest(drawLayout_runsOverAdjacentItems) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(20, 4);
+  lcd.print("old text");
+
+  model.resetCounts();
+  lcd.drawLayout(status);
+  assertEqual("Temp      C         ", model.text(0x00, 20));
+  assertEqual("Fault:              ", model.text(0x54, 20));
+  // row 0 is one run; the field on row 3 starts a column after its label
+  assertEqual(1 + 2, model.commands);
+  assertEqual(4 + 6 + 1 + 6 + 13, model.writes);
+
+  lcd.setCursor(&status[1]);
+  lcd.print("21.5");
+  lcd.setCursor(&status[4]);
+  lcd.print("E12 fan");
+  assertEqual("Temp21.5  C         ", model.text(0x00, 20));
+  assertEqual("Fault: E12 fan      ", model.text(0x54, 20));
+}
+
+unittest(drawLayout_drawsLeftToRightWhateverTheEntryMode) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(20, 4);
+  lcd.rightToLeft();
+
+  lcd.drawLayout(status);
+  assertEqual("Temp      C         ", model.text(0x00, 20));
+  assertEqual("Fault:              ", model.text(0x54, 20));
+  assertFalse(model.increment);
+}
+
+unittest(drawLayout_mock) {
+  LiquidCrystal lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(20, 4);
+  lcd.drawLayout(status);
+  std::vector<String> lines = lcd.getLines();
+  assertEqual("Temp      C", lines.at(0));
+  assertEqual("Fault:              ", lines.at(3));
+
+  lcd.setCursor(&status[4]);
+  assertEqual(7, lcd.getCursorCol());
+  assertEqual(3, lcd.getCursorRow());
+}
+
+unittest_main()
@@ -0,0 +1,175 @@
+#include <vector>
+
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "LiquidCrystal_CI.h"
+#include "LiquidCrystal_Mirror.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+// a Stream that keeps what is written to it and reads back `input`
+class Capture : public Stream {
+public:
+  virtual size_t write(uint8_t value) {
+    out.push_back(value);
+    return 1;
+  }
+  virtual int available() { return strlen(input); }
+  virtual int read() { return *input ? *input++ : -1; }
+  virtual int peek() { return *input ? *input : -1; }
+
+  std::vector<uint8_t> out;
+  const char *input = "";
+};
+
+// checks one packet at `at` and moves past it; returns its type
+uint8_t packet(const std::vector<uint8_t> &out, size_t &at,
+               std::vector<uint8_t> &payload) {
+  if (at + 4 > out.size() || out[at] != LCD_MIRROR_SYNC) {
+    return 0;
+  }
+  uint8_t type = out[at + 1];
+  uint8_t length = out[at + 2];
+  uint8_t check = type ^ length;
+  payload.assign(out.begin() + at + 3, out.begin() + at + 3 + length);
+  for (size_t i = 0; i < payload.size(); i++) {
+    check ^= payload[i];
+  }
+  if (check != out[at + 3 + length]) {
+    return 0;
+  }
+  at += 4 + length;
+  return type;
+}
+
+unittest(mirror_needsShadow) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  Capture capture;
+  LiquidCrystal_Mirror mirror(lcd, capture);
+  assertFalse(mirror.begin());
+  assertFalse(mirror.update());
+  assertEqual(0, capture.out.size());
+}
+
+unittest(mirror_keyframeThenDeltas) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  lcd.attachShadow(shadow);
+  Capture capture;
+  LiquidCrystal_Mirror mirror(lcd, capture, 100);
+  assertTrue(mirror.begin());
+  lcd.print("Boiler");
+
+  delay(100);
+  assertTrue(mirror.update());
+  size_t at = 0;
+  std::vector<uint8_t> payload;
+  assertEqual(LCD_MIRROR_KEYFRAME, packet(capture.out, at, payload));
+  assertEqual(2 + 32, payload.size());
+  assertEqual(16, payload[0]);
+  assertEqual(2, payload[1]);
+  assertEqual('B', payload[2]);
+  assertEqual(at, capture.out.size());
+
+  // too soon after the last update
+  lcd.setCursor(0, 1);
+  lcd.print("72C");
+  assertFalse(mirror.update());
+
+  // only the changed cells go out; rewriting a cell with the same character
+  // isn't a change
+  lcd.setCursor(0, 0);
+  lcd.print("Boil");
+  delay(100);
+  assertTrue(mirror.update());
+  assertEqual(LCD_MIRROR_RUN, packet(capture.out, at, payload));
+  assertEqual(4, payload.size());
+  assertEqual(16, payload[0]);
+  assertEqual('7', payload[1]);
+  assertEqual('C', payload[3]);
+  assertEqual(at, capture.out.size());
+
+  // nothing changed
+  delay(100);
+  assertFalse(mirror.update());
+}
+
+unittest(mirror_glyphsAndKeyframeRequest) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2], cgram[64];
+  lcd.attachShadow(shadow);
+  lcd.attachCharCache(cgram);
+  Capture capture;
+  LiquidCrystal_Mirror mirror(lcd, capture, 0);
+  mirror.begin();
+  assertTrue(mirror.update());
+  capture.out.clear();
+
+  uint8_t heart[8] = {0, 10, 31, 31, 14, 4, 0, 0};
+  lcd.createChar(3, heart);
+  assertTrue(mirror.update());
+  size_t at = 0;
+  std::vector<uint8_t> payload;
+  assertEqual(LCD_MIRROR_GLYPH, packet(capture.out, at, payload));
+  assertEqual(3, payload[0]);
+  assertEqual(31, payload[3]);
+  assertEqual(at, capture.out.size());
+
+  // the other end asks for the whole screen
+  capture.out.clear();
+  capture.input = "K";
+  assertTrue(mirror.update());
+  at = 0;
+  assertEqual(LCD_MIRROR_KEYFRAME, packet(capture.out, at, payload));
+  for (int i = 0; i < 8; i++) {
+    assertEqual(LCD_MIRROR_GLYPH, packet(capture.out, at, payload));
+  }
+  assertEqual(at, capture.out.size());
+}
+
+unittest(mirror_leavesOtherInputAlone) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  lcd.attachShadow(shadow);
+  Capture capture;
+  LiquidCrystal_Mirror mirror(lcd, capture, 0);
+  mirror.begin();
+  assertTrue(mirror.update());
+
+  capture.out.clear();
+  capture.input = "Kset 5";
+  assertTrue(mirror.update());
+  assertEqual('s', capture.read());
+  size_t at = 0;
+  std::vector<uint8_t> payload;
+  assertEqual(LCD_MIRROR_KEYFRAME, packet(capture.out, at, payload));
+}
+
+unittest(mirror_stopsWhenTheShadowGoes) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  lcd.attachShadow(shadow);
+  Capture capture;
+  LiquidCrystal_Mirror mirror(lcd, capture, 0);
+  assertTrue(mirror.begin());
+  lcd.attachShadow(NULL);
+  lcd.print("x");
+  assertFalse(mirror.update());
+
+  mirror.keyframe();
+  assertFalse(mirror.update());
+  assertEqual(0, capture.out.size());
+}
+
+unittest_main()
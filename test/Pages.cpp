@@ -0,0 +1,200 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+#include "LiquidCrystal_Page.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+unittest(shadow_followsWrites) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  lcd.attachShadow(shadow);
+  assertEqual(' ', shadow[0]);
+
+  lcd.print("Hi");
+  lcd.setCursor(14, 1);
+  lcd.print(F("there"));
+  assertEqual('H', shadow[0]);
+  assertEqual('i', shadow[1]);
+  assertEqual('t', shadow[16 + 14]);
+  assertEqual('h', shadow[16 + 15]);
+
+  lcd.clear();
+  assertEqual(' ', shadow[0]);
+  assertEqual(' ', shadow[16 + 14]);
+}
+
+unittest(page_writesDoNotTouchTheBus) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t buffer[16 * 2];
+  LiquidCrystal_Page page(lcd, buffer, 16, 2);
+
+  glass.resetCounts();
+  page.setCursor(3, 1);
+  page.print("menu");
+  page.blink();
+  assertEqual(0, glass.commands + glass.writes);
+  assertEqual('m', buffer[16 + 3]);
+}
+
+unittest(show_sendsOnlyDifferences) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2], one[16 * 2], two[16 * 2];
+  lcd.attachShadow(shadow);
+  LiquidCrystal_Page first(lcd, one, 16, 2);
+  LiquidCrystal_Page second(lcd, two, 16, 2);
+
+  first.print("Temp    21.5 C");
+  first.setCursor(0, 1);
+  first.print("Menu");
+  second.print("Temp    22.0 C");
+  second.setCursor(0, 1);
+  second.print("Back");
+  second.setCursor(0, 1);
+  second.cursor();
+
+  first.show();
+  assertEqual(String("Temp    21.5 C  "), glass.text(0x00, 16));
+  assertEqual(String("Menu            "), glass.text(0x40, 16));
+
+  glass.resetCounts();
+  second.show();
+  // "2.0" as one run over the unchanged ".", "Back", the cursor setting and
+  // its position
+  assertEqual(7, glass.writes);
+  assertEqual(4, glass.commands);
+  assertEqual(String("Temp    22.0 C  "), glass.text(0x00, 16));
+  assertEqual(String("Back            "), glass.text(0x40, 16));
+  assertEqual(LCD_DISPLAYON | LCD_CURSORON, glass.displayControl);
+  assertEqual(0x40, glass.ac);
+
+  // showing the same page again only puts the cursor back
+  glass.resetCounts();
+  second.show();
+  assertEqual(0, glass.writes);
+  assertEqual(1, glass.commands);
+}
+
+unittest(show_withoutShadowRedrawsAll) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t buffer[16 * 2];
+  LiquidCrystal_Page page(lcd, buffer, 16, 2);
+  page.print("x");
+
+  glass.resetCounts();
+  page.show();
+  assertEqual(32, glass.writes);
+  assertEqual(String("x "), glass.text(0x00, 2));
+}
+
+unittest(show_refusesAPageOfAnotherSize) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t buffer[8 * 2];
+  LiquidCrystal_Page page(lcd, buffer, 8, 2);
+  page.print("x");
+
+  glass.resetCounts();
+  assertFalse(page.show());
+  assertEqual(0, glass.commands + glass.writes);
+}
+
+unittest(page_rightToLeftStopsAtTheFirstColumn) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t buffer[16 * 2];
+  LiquidCrystal_Page page(lcd, buffer, 16, 2);
+  page.rightToLeft();
+  page.setCursor(1, 0);
+  page.print("abc");
+  assertEqual('b', buffer[0]);
+  assertEqual('a', buffer[1]);
+  assertEqual(' ', buffer[15]);
+
+  assertTrue(page.show());
+  assertEqual(0x00, glass.ac);
+}
+
+unittest(page_decodesUtf8ApartFromTheDisplay) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2, LCD_5x8DOTS, LCD_ROM_A02);
+  uint8_t buffer[16 * 2];
+  LiquidCrystal_Page page(lcd, buffer, 16, 2);
+
+  page.write(0xC2); // a degree sign, interrupted by a u umlaut on the display
+  lcd.write(0xC3);
+  lcd.write(0xBC);
+  page.write(0xB0);
+  assertEqual(0xB0, buffer[0]);
+  assertEqual(0xFC, glass.ddram[0]);
+}
+
+unittest(drawFrame_runsFollowDdramAddresses) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(20, 4);
+  uint8_t shadow[20 * 4], frame[20 * 4];
+  lcd.attachShadow(shadow);
+  memset(frame, ' ', sizeof(frame));
+
+  // row 0 ends at 0x13 and row 2 starts at 0x14; row 2 ends at 0x27 and the
+  // controller goes on at 0x40, where row 1 starts
+  frame[0 * 20 + 19] = 'a';
+  frame[2 * 20 + 0] = 'b';
+  frame[2 * 20 + 19] = 'c';
+  frame[1 * 20 + 0] = 'd';
+  glass.resetCounts();
+  lcd.drawFrame(frame);
+  assertEqual(4, glass.writes);
+  assertEqual(2, glass.commands);
+  assertEqual('a', glass.ddram[0x13]);
+  assertEqual('b', glass.ddram[0x14]);
+  assertEqual('c', glass.ddram[0x27]);
+  assertEqual('d', glass.ddram[0x40]);
+}
+
+unittest(drawFrame_rightToLeft) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2], frame[16 * 2];
+  lcd.attachShadow(shadow);
+  memset(frame, ' ', sizeof(frame));
+  memcpy(frame, "abc", 3);
+  lcd.rightToLeft();
+  lcd.drawFrame(frame);
+  assertEqual(String("abc "), glass.text(0x00, 4));
+  assertFalse(glass.increment);
+}
+
+unittest(page_rightToLeft) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t buffer[16 * 2];
+  LiquidCrystal_Page page(lcd, buffer, 16, 2);
+  page.setCursor(5, 0);
+  page.rightToLeft();
+  page.print("abc");
+  assertEqual('a', buffer[5]);
+  assertEqual('b', buffer[4]);
+  assertEqual('c', buffer[3]);
+}
+
+unittest_main()
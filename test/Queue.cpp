@@ -0,0 +1,107 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+#include "LiquidCrystal_Queue.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+unittest(push_doesNotTouchTheBus) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Queue queue(lcd);
+
+  glass.resetCounts();
+  assertTrue(queue.push(0, 1, "FAULT"));
+  assertEqual(1, queue.pending());
+  assertEqual(0, glass.commands + glass.writes);
+
+  assertEqual(1, queue.drain());
+  assertEqual(0, queue.pending());
+  assertEqual(String("FAULT"), glass.text(0x40, 5));
+}
+
+unittest(drain_sendsOnlyTheLatestText) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Queue queue(lcd);
+
+  queue.push(0, 0, "T=20.1");
+  queue.push(0, 0, "T=20.4");
+  queue.push(4, 0, "7 C");
+  queue.push(0, 1, "ok");
+
+  glass.resetCounts();
+  assertEqual(4, queue.drain());
+  // "T=20" from the second patch, "7 C" from the third, "ok" from the last
+  assertEqual(3, glass.commands);
+  assertEqual(9, glass.writes);
+  assertEqual(String("T=207 C"), glass.text(0x00, 7));
+  assertEqual(String("ok"), glass.text(0x40, 2));
+}
+
+unittest(drain_inBatches) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Queue queue(lcd);
+
+  queue.push(0, 0, "a");
+  queue.push(1, 0, "b");
+  queue.push(2, 0, "c");
+  assertEqual(2, queue.drain(2));
+  assertEqual(String("ab "), glass.text(0x00, 3));
+  assertEqual(1, queue.drain(2));
+  assertEqual(String("abc"), glass.text(0x00, 3));
+  assertEqual(0, queue.drain());
+}
+
+unittest(push_dropsWhenFull) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Queue queue(lcd);
+
+  // one slot always stays empty to tell a full ring from an empty one
+  for (int i = 0; i < LCD_QUEUE_SIZE - 1; i++) {
+    assertTrue(queue.push(i, 0, "x"));
+  }
+  assertFalse(queue.push(0, 1, "lost"));
+  assertEqual(1, queue.dropped());
+  assertEqual(LCD_QUEUE_SIZE - 1, queue.pending());
+
+  // wrapping around the ring
+  queue.drain();
+  for (int i = 0; i < LCD_QUEUE_SIZE - 1; i++) {
+    assertTrue(queue.push(i, 1, "y"));
+  }
+  assertEqual(LCD_QUEUE_SIZE - 1, queue.drain());
+}
+
+unittest(push_cutsLongText) {
+  Hd44780 glass(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(20, 2);
+  LiquidCrystal_Queue queue(lcd);
+
+  queue.push(0, 0, "0123456789abcdefXYZ");
+  queue.drain();
+  assertEqual(String("0123456789abcdef    "), glass.text(0x00, 20));
+
+  // a string longer than 255 characters is cut too, not wrapped to nothing
+  char text[257];
+  memset(text, 'L', 256);
+  text[256] = 0;
+  queue.push(0, 1, text);
+  queue.drain();
+  assertEqual(String("LLLLLLLLLLLLLLLL    "), glass.text(0x40, 20));
+}
+
+unittest_main()
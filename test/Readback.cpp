@@ -0,0 +1,118 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d0 = 10;
+const byte d1 = 11;
+const byte d2 = 12;
+const byte d3 = 13;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+unittest(read_needsRw) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t buffer[4];
+  assertEqual(LCD_NOCHAR, lcd.readAddressCounter());
+  assertEqual(0, lcd.readDDRAM(0, buffer, sizeof(buffer)));
+}
+
+unittest(read_fourBit) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, rw, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  lcd.setCursor(3, 1);
+  lcd.print("Volts");
+  assertEqual(0x48, lcd.readAddressCounter());
+
+  uint8_t buffer[5];
+  assertEqual(5, lcd.readDDRAM(0x43, buffer, sizeof(buffer)));
+  assertEqual('V', buffer[0]);
+  assertEqual('s', buffer[4]);
+
+  uint8_t heart[8] = {0, 10, 31, 31, 14, 4, 0, 0};
+  lcd.createChar(2, heart);
+  assertEqual(5, lcd.readCGRAM(2 * 8, buffer, 5));
+  assertEqual(31, buffer[2]);
+  assertEqual(14, buffer[4]);
+
+  // reading doesn't move where the sketch writes next
+  lcd.setCursor(8, 1);
+  lcd.readDDRAM(0x00, buffer, 2);
+  lcd.print("!");
+  assertEqual("   Volts!       ", model.text(0x40, 16));
+}
+
+unittest(read_eightBitRightToLeft) {
+  Hd44780 model(rs, rw, enable, d0, d1, d2, d3, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, rw, enable, d0, d1, d2, d3, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  lcd.print("abc");
+  lcd.rightToLeft();
+
+  uint8_t buffer[3];
+  lcd.readDDRAM(0x00, buffer, sizeof(buffer));
+  assertEqual('a', buffer[0]);
+  assertEqual('c', buffer[2]);
+  assertFalse(model.increment);
+}
+
+unittest(verify_repairsScrambledCells) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, rw, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.print("Temp 21.5C");
+  lcd.setCursor(0, 1);
+  lcd.print("Fan on");
+  assertEqual(0, lcd.verify());
+
+  // noise changes a few cells behind the driver's back
+  model.ddram[0x05] = '#';
+  model.ddram[0x06] = '#';
+  model.ddram[0x4E] = 0xFF;
+  assertEqual(3, lcd.verify(false));
+  assertEqual('#', model.ddram[0x05]);
+
+  model.resetCounts();
+  assertEqual(3, lcd.verify());
+  assertEqual(3, model.writes);
+  assertEqual("Temp 21.5C      ", model.text(0x00, 16));
+  assertEqual("Fan on          ", model.text(0x40, 16));
+  assertEqual(0, lcd.verify());
+
+  // and the sketch carries on where it was
+  lcd.print("!");
+  assertEqual("Fan on!         ", model.text(0x40, 16));
+}
+
+unittest(verify_repairsLeftToRightWhateverTheEntryMode) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, rw, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.print("ABCDEF");
+  lcd.setCursor(15, 1);
+  lcd.rightToLeft();
+
+  model.ddram[0x01] = 'x';
+  model.ddram[0x02] = 'y';
+  model.ddram[0x03] = 'z';
+  assertEqual(3, lcd.verify());
+  assertEqual("ABCDEF          ", model.text(0x00, 16));
+  assertFalse(model.increment);
+  assertEqual(0, lcd.verify());
+
+  lcd.print("ko");
+  assertEqual("              ok", model.text(0x40, 16));
+}
+
+unittest_main()
@@ -0,0 +1,111 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+#include "LiquidCrystal_Reading.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+unittest(reading_ignoresNoiseInsideTheDeadband) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Reading reading(lcd, 4, 0, 5, 1);
+  reading.setDeadband(2);
+
+  assertEqual(LCD_READING_CHANGED, reading.update(215, 0));
+  assertEqual(" 21.5", model.text(0x04, 5));
+
+  // a quiet sensor sends nothing
+  model.resetCounts();
+  assertEqual(0, reading.update(216, 10));
+  assertEqual(0, reading.update(214, 20));
+  assertEqual(0, reading.update(217, 30));
+  assertEqual(0, model.writes + model.commands);
+  assertEqual(215, reading.shown());
+
+  // a real move is drawn
+  assertEqual(LCD_READING_CHANGED, reading.update(220, 40));
+  assertEqual(" 22.0", model.text(0x04, 5));
+}
+
+unittest(reading_keepsToItsIntervals) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Reading reading(lcd, 0, 1, 4);
+  reading.setDeadband(5);
+  reading.setInterval(100, 1000);
+  reading.update(100, 0);
+
+  // not before the minimum interval, however far it moves
+  assertEqual(0, reading.update(200, 50));
+  assertEqual(" 100", model.text(0x40, 4));
+  assertEqual(LCD_READING_CHANGED, reading.update(200, 100));
+  assertEqual(" 200", model.text(0x40, 4));
+
+  // a drift inside the deadband shows after the maximum interval
+  assertEqual(0, reading.update(203, 500));
+  assertEqual(LCD_READING_CHANGED, reading.update(203, 1100));
+  assertEqual(" 203", model.text(0x40, 4));
+}
+
+unittest(reading_reportsThresholdsWithHysteresis) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Reading reading(lcd, 0, 0, 3);
+  reading.setDeadband(10);
+  reading.setInterval(1000);
+  reading.setThreshold(80, 2);
+  reading.update(75, 0);
+
+  // a crossing is drawn at once, whatever the deadband and interval
+  assertEqual(LCD_READING_ABOVE | LCD_READING_CHANGED,
+              reading.update(81, 10));
+  assertEqual(" 81", model.text(0x00, 3));
+  assertTrue(reading.above());
+
+  // no chatter around the threshold
+  assertEqual(0, reading.update(79, 20));
+  assertEqual(0, reading.update(81, 30));
+  assertEqual(LCD_READING_BELOW | LCD_READING_CHANGED,
+              reading.update(77, 40));
+  assertFalse(reading.above());
+}
+
+unittest(reading_redrawsAfterTheScreenWasCleared) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Reading reading(lcd, 0, 0, 3);
+  reading.update(42, 0);
+  lcd.clear();
+  assertEqual(0, reading.update(42, 10));
+  reading.redraw();
+  assertEqual(LCD_READING_CHANGED, reading.update(42, 20));
+  assertEqual(" 42", model.text(0x00, 3));
+}
+
+unittest(reading_keepsAnOverlongValueInsideTheField) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  lcd.print("abcdefghijklmnop");
+  LiquidCrystal_Reading reading(lcd, 4, 0, 5, 1);
+
+  reading.update(123456, 0);
+  assertEqual("abcd#####jklmnop", model.text(0x00, 16));
+  reading.update(-9999, 10);
+  assertEqual("abcd#####jklmnop", model.text(0x00, 16));
+  reading.update(-999, 20);
+  assertEqual("abcd-99.9jklmnop", model.text(0x00, 16));
+}
+
+unittest_main()
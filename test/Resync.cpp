@@ -0,0 +1,114 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+// one enable pulse the driver didn't send, as noise on the line would give
+void glitch() {
+  digitalWrite(enable, HIGH);
+  digitalWrite(enable, LOW);
+}
+
+uint8_t heart[8] = {0, 10, 31, 31, 14, 4, 0, 0};
+
+unittest(resync_recoversNibblePhase) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  uint8_t cache[64];
+  lcd.attachShadow(shadow);
+  lcd.attachCharCache(cache);
+  lcd.createChar(1, heart);
+  lcd.setCursor(0, 0);
+  lcd.blink();
+  lcd.print("Hi");
+
+  glitch();
+  lcd.print(" there");
+  assertNotEqual("Hi there        ", model.text(0x00, 16));
+  model.cgram[8 + 2] = 0;
+
+  GodmodeState *state = GODMODE();
+  unsigned long start = state->micros;
+  lcd.resync();
+  assertLess(state->micros - start, 50000UL); // no power-on wait
+  assertFalse(model.eightBit);
+  assertEqual("Hi there        ", model.text(0x00, 16));
+  assertEqual("                ", model.text(0x40, 16));
+  assertEqual(31, model.cgram[8 + 2]);
+  assertEqual(LCD_DISPLAYON | LCD_BLINKON, model.displayControl);
+
+  lcd.write(1);
+  assertEqual(1, model.ddram[8]);
+}
+
+unittest(resync_withRwRewritesOnlyWrongCells) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, rw, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.print("Pump 1 on");
+  lcd.setCursor(0, 1);
+
+  glitch();
+  lcd.print("ok");
+  model.resetCounts();
+  lcd.resync();
+  assertEqual("Pump 1 on       ", model.text(0x00, 16));
+  assertEqual("ok              ", model.text(0x40, 16));
+  assertLess(model.writes, 32);
+}
+
+unittest(resync_redrawsLeftToRightWhateverTheEntryMode) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.print("Hello");
+  lcd.setCursor(15, 1);
+  lcd.rightToLeft();
+  lcd.print("dlrow");
+
+  glitch();
+  lcd.print("!");
+  lcd.resync();
+  assertEqual("Hello           ", model.text(0x00, 16));
+  assertEqual("          !world", model.text(0x40, 16));
+  assertFalse(model.increment);
+
+  // and the sketch goes on right to left where it was
+  lcd.print("?");
+  assertEqual("         ?!world", model.text(0x40, 16));
+}
+
+unittest(resync_reloadsCgramLeftToRightWhateverTheEntryMode) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t cache[64];
+  lcd.attachCharCache(cache);
+  lcd.createChar(1, heart);
+  lcd.rightToLeft();
+
+  glitch();
+  memset(model.cgram, 0, sizeof(model.cgram));
+  lcd.resync();
+  for (uint8_t i = 0; i < 8; i++) {
+    assertEqual(heart[i], model.cgram[8 + i]);
+  }
+  assertEqual(0, model.cgram[0x33]);
+  assertFalse(model.increment);
+}
+
+unittest_main()
@@ -0,0 +1,89 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+unittest(printRight_takesOneAddressSet) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+
+  model.resetCounts();
+  lcd.printRight(15, 1, -1234);
+  assertEqual("          -1234", model.text(0x41, 15));
+  assertEqual(5, model.writes);
+  assertEqual(3, model.commands); // entry mode, address, entry mode back
+  assertTrue(model.increment);
+
+  // a shorter number covers the longer one
+  lcd.printRight(15, 1, 7, 5);
+  assertEqual("    7", model.text(0x4B, 5));
+
+  // and text goes on left to right from where the cursor is
+  lcd.setCursor(0, 0);
+  lcd.print("ok");
+  assertEqual("ok", model.text(0x00, 2));
+}
+
+unittest(printRight_placesTheDecimalPoint) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  lcd.printRight(5, 0, 2150, 6, 2);
+  assertEqual(" 21.50", model.text(0x00, 6));
+  lcd.printRight(5, 0, -5, 6, 1);
+  assertEqual("  -0.5", model.text(0x00, 6));
+}
+
+unittest(writeRTL_streamsLeftwards) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  lcd.autoscroll();
+
+  model.resetCounts();
+  lcd.writeRTL(9, 0, (const uint8_t *)"abc", 3);
+  assertEqual("cba", model.text(0x07, 3));
+  assertEqual(3, model.commands); // autoscroll is off for the run only
+
+  // the cursor is left of the last character
+  lcd.cursor();
+  assertEqual(0x06, model.ac);
+}
+
+unittest(writeRTL_tracksTheCursorInTheTestClass) {
+  LiquidCrystal_CI lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  lcd.setCursor(0, 1);
+  lcd.print("Total");
+  lcd.printRight(15, 1, 42, 4);
+  std::vector<String> lines = lcd.getLines();
+  assertEqual("Total         42", lines.at(1));
+  assertEqual(11, lcd.getCursorCol());
+
+  lcd.writeRTL(4, 0, (const uint8_t *)"olleh", 5);
+  lines = lcd.getLines();
+  assertEqual("hello", lines.at(0));
+  assertEqual(-1, lcd.getCursorCol());
+}
+
+unittest(rightToLeft_movesTheCursorInTheTestClass) {
+  LiquidCrystal_CI lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  lcd.setCursor(5, 0);
+  lcd.rightToLeft();
+  lcd.print("abc");
+  std::vector<String> lines = lcd.getLines();
+  assertEqual("   cba", lines.at(0));
+  assertEqual(2, lcd.getCursorCol());
+}
+
+unittest_main()
@@ -0,0 +1,67 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "LiquidCrystal_Samples.h"
+
+unittest(samples_windowsAggregateEverySample) {
+  LiquidCrystal_Samples samples;
+  LiquidCrystal_Window window;
+  assertFalse(samples.window(window));
+
+  samples.add(10, 1000);
+  samples.add(-4, 2000);
+  samples.add(30, 3000);
+  assertTrue(samples.window(window));
+  assertEqual(-4, window.min);
+  assertEqual(30, window.max);
+  assertEqual(3, window.count);
+  assertEqual(12, window.mean());
+  assertEqual(1000, window.first);
+  assertEqual(3000, window.last);
+
+  // the next window starts empty
+  samples.add(7, 4000);
+  assertTrue(samples.window(window));
+  assertEqual(7, window.min);
+  assertEqual(7, window.max);
+  assertEqual(1, window.count);
+  assertFalse(samples.window(window));
+}
+
+unittest(samples_ringKeepsTheRawSamplesInOrder) {
+  LiquidCrystal_Samples samples;
+  samples.add(1, 100);
+  samples.add(2, 200);
+  assertEqual(2, samples.pending());
+
+  LiquidCrystal_Sample sample;
+  assertTrue(samples.take(sample));
+  assertEqual(1, sample.value);
+  assertEqual(100, sample.time);
+  assertTrue(samples.take(sample));
+  assertEqual(2, sample.value);
+  assertFalse(samples.take(sample));
+}
+
+unittest(samples_aFullRingStillCountsTowardsTheWindow) {
+  LiquidCrystal_Samples samples;
+  // a kHz producer against a display that looks every 250 ms
+  for (int i = 0; i < 250; i++) {
+    samples.add(i, i * 1000UL);
+  }
+  assertEqual(LCD_SAMPLE_RING - 1, samples.pending());
+  assertEqual(250 - (LCD_SAMPLE_RING - 1), samples.dropped());
+
+  LiquidCrystal_Window window;
+  assertTrue(samples.window(window));
+  assertEqual(250, window.count);
+  assertEqual(0, window.min);
+  assertEqual(249, window.max);
+  assertEqual(124, window.mean());
+
+  // the ring has the oldest ones
+  LiquidCrystal_Sample sample;
+  assertTrue(samples.take(sample));
+  assertEqual(0, sample.value);
+}
+
+unittest_main()
@@ -0,0 +1,90 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "SensorLog.h"
+
+// collects what is written, and how
+class Sink : public Print {
+public:
+  Sink() : length(0), writes(0) {}
+  size_t write(uint8_t value) {
+    data[length++] = value;
+    return 1;
+  }
+  size_t write(const uint8_t *buffer, size_t size) {
+    memcpy(data + length, buffer, size);
+    length += size;
+    writes++;
+    return size;
+  }
+  uint8_t data[256];
+  size_t length;
+  int writes;
+};
+
+unittest(log_encodesCompactRecords) {
+  Sink sink;
+  uint8_t block[32];
+  SensorLog log(sink, block, sizeof(block));
+  assertTrue(log.add(0, 512, 1000));
+  assertTrue(log.add(0, 510, 2000));
+  assertTrue(log.add(1, -3, 2000));
+  assertFalse(log.add(SENSOR_LOG_CHANNELS, 0, 2000));
+  assertEqual(0, sink.length); // nothing until the block is done
+
+  log.flush();
+  assertEqual(1, sink.writes);
+  assertEqual(sizeof(block), sink.length);
+  const uint8_t expected[] = {
+      SENSOR_LOG_SYNC, 'L', 32, 0, 0xE8, 0x03, 0, 0, // header: time 1000
+      0, 0, 0x80, 0x08,                           // +0 us, 512
+      0, 0xE8, 0x07, 3,                           // +1000 us, -2
+      1, 0, 5,                                    // +0 us, -3
+      SENSOR_LOG_PAD};
+  for (size_t i = 0; i < sizeof(expected); i++) {
+    assertEqual(expected[i], sink.data[i]);
+  }
+  assertEqual(SENSOR_LOG_PAD, sink.data[31]);
+
+  // an empty block isn't written
+  log.flush();
+  assertEqual(1, sink.writes);
+}
+
+unittest(log_writesWholeBlocks) {
+  Sink sink;
+  uint8_t block[32];
+  SensorLog log(sink, block, sizeof(block));
+  // four records fit in a block after the header
+  for (int i = 0; i < 9; i++) {
+    log.add(0, 100 + i, i * 1000UL);
+  }
+  assertEqual(2, log.blocks());
+  assertEqual(2 * sizeof(block), sink.length);
+  assertEqual(2, sink.writes);
+
+  // every block starts over, so it decodes on its own
+  assertEqual(SENSOR_LOG_SYNC, sink.data[32]);
+  assertEqual('L', sink.data[33]);
+  assertEqual(0xA0, sink.data[32 + 4]); // time 4000
+  assertEqual(0x0F, sink.data[32 + 5]);
+  assertEqual(0, sink.data[32 + SENSOR_LOG_HEADER]);
+  assertEqual(0, sink.data[32 + SENSOR_LOG_HEADER + 1]); // +0 us
+  assertEqual(0xD0, sink.data[32 + SENSOR_LOG_HEADER + 2]); // 104, from 0
+  assertEqual(0x01, sink.data[32 + SENSOR_LOG_HEADER + 3]);
+}
+
+unittest(log_needsRoomForARecord) {
+  Sink sink;
+  uint8_t block[SENSOR_LOG_HEADER + SENSOR_LOG_RECORD];
+  SensorLog small(sink, block, sizeof(block) - 1);
+  assertFalse(small.add(0, 1, 0));
+  small.flush();
+  assertEqual(0, sink.length);
+
+  SensorLog log(sink, block, sizeof(block));
+  assertTrue(log.add(0, 1, 0));
+  assertTrue(log.add(0, 1 << 30, 0xFFFFFFFF)); // the longest record
+  assertEqual(1, log.blocks());
+}
+
+unittest_main()
@@ -0,0 +1,83 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+unittest(skipUnchanged_sendsOnlyWhatDiffers) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.skipUnchanged();
+  lcd.print("Temp: 21.5 C");
+
+  model.resetCounts();
+  lcd.setCursor(0, 0);
+  lcd.print("Temp: 21.5 C");
+  assertEqual(0, model.writes);
+  assertEqual(1, model.commands); // only the setCursor()
+
+  model.resetCounts();
+  lcd.setCursor(0, 0);
+  lcd.print("Temp: 22.0 C");
+  assertEqual("Temp: 22.0 C    ", model.text(0x00, 16));
+  assertEqual(2, model.writes);       // '2' and '0'
+  assertEqual(1 + 2, model.commands); // setCursor(), then an address for each
+
+  // the next character goes where the sketch expects
+  lcd.print("!");
+  assertEqual("Temp: 22.0 C!   ", model.text(0x00, 16));
+}
+
+unittest(skipUnchanged_resyncsBeforeOtherCommands) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.skipUnchanged();
+  lcd.print("Menu");
+  lcd.setCursor(0, 0);
+  lcd.print("Menu");
+  assertEqual(0x00, model.ac);
+
+  // the cursor shows where the skipped text ended
+  lcd.cursor();
+  assertEqual(0x04, model.ac);
+
+  // and nothing is skipped while it shows
+  model.resetCounts();
+  lcd.setCursor(0, 0);
+  lcd.print("Menu");
+  assertEqual(4, model.writes);
+}
+
+unittest(skipUnchanged_off) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  uint8_t shadow[16 * 2];
+  lcd.attachShadow(shadow);
+  lcd.skipUnchanged();
+  lcd.print("ab");
+  lcd.home();
+  lcd.print("ab");
+  lcd.skipUnchanged(false);
+  assertEqual(0x02, model.ac);
+
+  model.resetCounts();
+  lcd.home();
+  lcd.print("ab");
+  assertEqual(2, model.writes);
+}
+
+unittest_main()
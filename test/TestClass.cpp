@@ -373,4 +373,38 @@ unittest(createChar_and_print) {
   assertEqual(0, lines.at(1).length());
 }
 
+unittest(printUtf8_high) {
+  LiquidCrystal_Test lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2, LCD_5x8DOTS, LCD_ROM_A02);
+  lcd.print("25\xC2\xB0"
+            "C");
+  std::vector<String> lines = lcd.getLines();
+  assertEqual(4, lines.at(0).length());
+  assertEqual("25\xB0"
+              "C",
+              lines.at(0));
+  assertEqual(4, lcd.getCursorCol());
+}
+
+// the mock follows the bus, so it sees what the library draws however it
+// was called
+unittest(tracksTheBusNotTheApi) {
+  LiquidCrystal_Test lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  LiquidCrystal_Base &base = lcd;
+  base.drawScreen(F("Hello\nthere"));
+  std::vector<String> lines = lcd.getLines();
+  assertEqual("Hello           ", lines.at(0));
+  assertEqual("there           ", lines.at(1));
+
+  base.printRight(15, 1, 42, 4);
+  lines = lcd.getLines();
+  assertEqual("there         42", lines.at(1));
+
+  base.setCursor(3, 0);
+  assertEqual(3, lcd.getCursorCol());
+  assertEqual(0, lcd.getCursorRow());
+  assertTrue(lcd.isDisplay());
+}
+
 unittest_main()
@@ -0,0 +1,76 @@
+#include "Arduino.h"
+#include "ArduinoUnitTests.h"
+#include "Hd44780.h"
+#include "LiquidCrystal_CI.h"
+
+const byte rs = 1;
+const byte rw = 2;
+const byte enable = 3;
+const byte d4 = 14;
+const byte d5 = 15;
+const byte d6 = 16;
+const byte d7 = 17;
+
+// how long one character takes to send
+unsigned long writeTime(LiquidCrystal_Base &lcd) {
+  GodmodeState *state = GODMODE();
+  unsigned long start = state->micros;
+  lcd.write('x');
+  return state->micros - start;
+}
+
+unittest(timing_profiles) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  assertEqual(100, lcd.timing().settle);
+  assertEqual(2 * (1 + 1 + 100), writeTime(lcd));
+
+  static const LiquidCrystal_Timing st7066u = LCD_TIMING_ST7066U;
+  lcd.setTiming(st7066u);
+  assertEqual(2 * (1 + 1 + 45), writeTime(lcd));
+
+  GodmodeState *state = GODMODE();
+  unsigned long start = state->micros;
+  lcd.home();
+  assertEqual(2000 + 2 * (1 + 1 + 45), state->micros - start);
+}
+
+unittest(calibrate_needsRw) {
+  LiquidCrystal_Base lcd(rs, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  assertFalse(lcd.calibrate());
+  assertEqual(100, lcd.timing().settle);
+}
+
+unittest(calibrate_measuresBusyFlag) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, rw, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  lcd.print("Hello");
+
+  // each status read takes two 2 us nibbles in the mock
+  model.busyPolls = 5;
+  model.busyPollsSlow = 300;
+  assertTrue(lcd.calibrate());
+  assertMoreOrEqual(lcd.timing().settle, 5 * 4);
+  assertLess(lcd.timing().settle, 40);
+  assertMoreOrEqual(lcd.timing().clear, 300 * 4);
+  assertLess(lcd.timing().clear, 2000);
+
+  // the display is as it was, and writing carries on where it left off
+  model.busyPolls = model.busyPollsSlow = 0;
+  lcd.print("!");
+  assertEqual("Hello!          ", model.text(0x00, 16));
+  assertEqual(' ', model.ddram[0x27]);
+}
+
+unittest(calibrate_givesUpOnStuckBusyFlag) {
+  Hd44780 model(rs, rw, enable, d4, d5, d6, d7);
+  LiquidCrystal_Base lcd(rs, rw, enable, d4, d5, d6, d7);
+  lcd.begin(16, 2);
+  model.busyPolls = 10000;
+  assertFalse(lcd.calibrate());
+  assertEqual(100, lcd.timing().settle);
+}
+
+unittest_main()